@@ -0,0 +1,239 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+// Not part of the benchmark executable: each function below is one loop iteration of the
+// benchmark with the same name, compiled on its own by benchmarks/tools/codegen_overhead.py and
+// disassembled, so the instructions an adaptor adds over the hand-written C can be counted.
+// The C functions are only declared, so every call to them survives optimization.
+// extern "C" keeps the symbol names equal to the benchmark names.
+
+// the "static" kernels measure the opt-in static deleter path
+#define ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR 1
+
+#include <benchmarks/refcounted.hpp>
+#include <benchmarks/unique_fd.hpp>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/static_deleter.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <cstddef>
+
+using unique_handle = std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter>;
+using static_handle = ztd::out_ptr::basic_c_handle<ficapi::opaque, decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+using shared_handle = std::shared_ptr<ficapi::opaque>;
+
+// local_out_ptr
+extern "C" int c_code_local_out_ptr() {
+	ficapi_opaque_handle p = NULL;
+	ficapi_handle_no_alloc_create(&p);
+	int x = ficapi_handle_get_data(p);
+	ficapi_handle_no_alloc_delete(p);
+	return x;
+}
+
+extern "C" int manual_local_out_ptr() {
+	unique_handle p(nullptr);
+	ficapi_opaque_handle temp_p = NULL;
+	ficapi_handle_no_alloc_create(&temp_p);
+	p.reset(temp_p);
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int simple_local_out_ptr() {
+	unique_handle p(nullptr);
+	ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::simple_out_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int clever_local_out_ptr() {
+	unique_handle p(nullptr);
+	ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int static_local_out_ptr() {
+	static_handle p(nullptr);
+	ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+// reset_out_ptr
+extern "C" int c_code_reset_out_ptr(ficapi_opaque_handle* p) {
+	if (*p != NULL) {
+		ficapi_handle_no_alloc_delete(*p);
+	}
+	ficapi_handle_no_alloc_create(p);
+	return ficapi_handle_get_data(*p);
+}
+
+extern "C" int manual_reset_out_ptr(unique_handle& p) {
+	ficapi_opaque_handle temp_p = NULL;
+	ficapi_handle_no_alloc_create(&temp_p);
+	p.reset(temp_p);
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int simple_reset_out_ptr(unique_handle& p) {
+	ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::simple_out_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int clever_reset_out_ptr(unique_handle& p) {
+	ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int static_reset_out_ptr(static_handle& p) {
+	ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+// local_inout_ptr
+extern "C" int c_code_local_inout_ptr() {
+	ficapi_opaque_handle p = NULL;
+	ficapi_handle_no_alloc_re_create(&p);
+	int x = ficapi_handle_get_data(p);
+	ficapi_handle_no_alloc_delete(p);
+	return x;
+}
+
+extern "C" int manual_local_inout_ptr() {
+	unique_handle p(nullptr);
+	ficapi_opaque_handle temp_p = NULL;
+	ficapi_handle_no_alloc_re_create(&temp_p);
+	p.reset(temp_p);
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int simple_local_inout_ptr() {
+	unique_handle p(nullptr);
+	ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::simple_inout_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int clever_local_inout_ptr() {
+	unique_handle p(nullptr);
+	ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int static_local_inout_ptr() {
+	static_handle p(nullptr);
+	ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+// reset_inout_ptr
+extern "C" int c_code_reset_inout_ptr(ficapi_opaque_handle* p) {
+	ficapi_handle_no_alloc_re_create(p);
+	return ficapi_handle_get_data(*p);
+}
+
+extern "C" int manual_reset_inout_ptr(unique_handle& p) {
+	ficapi_opaque_handle temp_p = p.release();
+	ficapi_handle_no_alloc_re_create(&temp_p);
+	p.reset(temp_p);
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int simple_reset_inout_ptr(unique_handle& p) {
+	ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::simple_inout_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int clever_reset_inout_ptr(unique_handle& p) {
+	ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int static_reset_inout_ptr(static_handle& p) {
+	ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+	return ficapi_handle_get_data(p.get());
+}
+
+// shared_reset_out_ptr: there is no C equivalent of the control block, so "manual" is the baseline
+extern "C" int manual_shared_reset_out_ptr(shared_handle& p) {
+	ficapi_opaque_handle temp_p = NULL;
+	ficapi_handle_no_alloc_create(&temp_p);
+	p.reset(temp_p, ficapi::handle_no_alloc_deleter());
+	return ficapi_handle_get_data(p.get());
+}
+
+extern "C" int out_ptr_shared_reset_out_ptr(shared_handle& p) {
+	ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, ficapi::handle_no_alloc_deleter()));
+	return ficapi_handle_get_data(p.get());
+}
+
+// intrusive_out_ptr
+extern "C" int c_code_intrusive_out_ptr(refcounted** p) {
+	if (*p != NULL) {
+		refcounted_release(*p);
+	}
+	void* temp_p = NULL;
+	refcounted_create(&temp_p);
+	*p = static_cast<refcounted*>(temp_p);
+	return refcounted_get_data(*p);
+}
+
+extern "C" int manual_intrusive_out_ptr(ref_handle& p) {
+	void* temp_p = NULL;
+	refcounted_create(&temp_p);
+	p.reset(static_cast<refcounted*>(temp_p), false);
+	return refcounted_get_data(p.get());
+}
+
+extern "C" int simple_intrusive_out_ptr(ref_handle& p) {
+	refcounted_create(ztd::out_ptr::op_detail::simple_out_ptr<void*>(p, false));
+	return refcounted_get_data(p.get());
+}
+
+extern "C" int clever_intrusive_out_ptr(ref_handle& p) {
+	refcounted_create(ztd::out_ptr::op_detail::clever_out_ptr<void*>(p, false));
+	return refcounted_get_data(p.get());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// fd_churn, for a single descriptor
+int open_event_fd(int* out);
+
+extern "C" int c_code_fd_churn(int* fd) {
+	if (*fd != -1) {
+		::close(*fd);
+	}
+	return open_event_fd(fd);
+}
+
+extern "C" int manual_fd_churn(unique_fd& fd) {
+	int temp_fd = -1;
+	int err     = open_event_fd(&temp_fd);
+	fd.reset(temp_fd);
+	return err;
+}
+
+extern "C" int simple_fd_churn(unique_fd& fd) {
+	return open_event_fd(ztd::out_ptr::op_detail::simple_out_ptr(fd));
+}
+
+extern "C" int clever_fd_churn(unique_fd& fd) {
+	return open_event_fd(ztd::out_ptr::op_detail::clever_out_ptr(fd));
+}
+
+#endif // POSIX
@@ -0,0 +1,46 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_ALLOCATION_COUNTER_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_ALLOCATION_COUNTER_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// number of calls made to the (replaced) global operator new on this thread
+std::uint64_t allocation_count() noexcept;
+
+struct allocation_tally {
+	std::uint64_t start;
+
+	allocation_tally() noexcept
+	: start(allocation_count()) {
+	}
+
+	std::uint64_t count() const noexcept {
+		return allocation_count() - start;
+	}
+
+	void report(benchmark::State& state) const {
+		state.counters["allocations"] = benchmark::Counter(static_cast<double>(this->count()), benchmark::Counter::kAvgIterations);
+	}
+};
+
+#endif
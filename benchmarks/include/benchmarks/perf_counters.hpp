@@ -0,0 +1,49 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_PERF_COUNTERS_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_PERF_COUNTERS_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr const std::size_t perf_event_count = 6;
+
+// The hardware performance counters of this thread, from perf_event_open on Linux:
+// counting starts on construction, and report() adds the counts per iteration to the
+// benchmark's user counters, as "instructions", "cycles", "branches", "branch_misses",
+// "l1d_misses" and "l1i_misses". Any counter the CPU, kernel or permissions
+// (kernel.perf_event_paranoid) do not provide is left out, and if that includes "cycles",
+// the time stamp counter is reported as "tsc_cycles" instead
+class perf_tally {
+public:
+	perf_tally() noexcept;
+	perf_tally(const perf_tally&) = delete;
+	perf_tally& operator=(const perf_tally&) = delete;
+	~perf_tally();
+
+	void report(benchmark::State& state);
+
+private:
+	int m_fds[perf_event_count];
+	std::uint64_t m_tsc_start;
+};
+
+#endif
@@ -0,0 +1,44 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_POOL_COUNTER_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_POOL_COUNTER_HPP
+
+#include <ztd/out_ptr/pooled_handle.hpp>
+
+#include <benchmark/benchmark.h>
+
+// how often this thread's handle pool had a warm handle for inout_ptr,
+// and how many handles it still had to destroy, per iteration
+template <typename Pool>
+struct pool_tally {
+	ztd::out_ptr::handle_pool_stats start;
+
+	pool_tally() noexcept
+	: start(Pool::stats()) {
+	}
+
+	void report(benchmark::State& state) const {
+		ztd::out_ptr::handle_pool_stats end = Pool::stats();
+		double hits						 = static_cast<double>(end.hits - this->start.hits);
+		double misses						 = static_cast<double>(end.misses - this->start.misses);
+		state.counters["pool_hit_rate"]	 = (hits + misses) == 0 ? 0.0 : hits / (hits + misses);
+		state.counters["pool_destroyed"]	 = benchmark::Counter(static_cast<double>(end.destroyed - this->start.destroyed), benchmark::Counter::kAvgIterations);
+	}
+};
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_REFCOUNTED_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_REFCOUNTED_HPP
+
+#include <ztd/out_ptr/is_intrusive_handle.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+// a COM-style C object: every create hands out one new reference through a void**.
+// Defined in its own translation unit, so the calls cannot be inlined away,
+// and it never allocates, so only the cost of the wrapper is measured
+struct refcounted;
+
+int refcounted_create(void** out);
+void refcounted_add_ref(refcounted* p);
+void refcounted_release(refcounted* p);
+int refcounted_get_data(const refcounted* p);
+
+// the in-house equivalent of boost::intrusive_ptr<refcounted>
+class ref_handle {
+public:
+	using element_type = refcounted;
+
+	ref_handle() noexcept
+	: m_ptr(nullptr) {
+	}
+	ref_handle(std::nullptr_t) noexcept
+	: m_ptr(nullptr) {
+	}
+	ref_handle(const ref_handle& right) noexcept
+	: m_ptr(right.m_ptr) {
+		if (this->m_ptr != nullptr) {
+			refcounted_add_ref(this->m_ptr);
+		}
+	}
+	ref_handle& operator=(const ref_handle& right) noexcept {
+		ref_handle(right).swap(*this);
+		return *this;
+	}
+	~ref_handle() {
+		if (this->m_ptr != nullptr) {
+			refcounted_release(this->m_ptr);
+		}
+	}
+
+	void reset() noexcept {
+		ref_handle().swap(*this);
+	}
+
+	void reset(refcounted* p, bool add_ref) noexcept {
+		if (add_ref && p != nullptr) {
+			refcounted_add_ref(p);
+		}
+		ref_handle old;
+		old.m_ptr   = this->m_ptr;
+		this->m_ptr = p;
+	}
+
+	refcounted* get() const noexcept {
+		return this->m_ptr;
+	}
+
+	void swap(ref_handle& right) noexcept {
+		refcounted* p = right.m_ptr;
+		right.m_ptr   = this->m_ptr;
+		this->m_ptr   = p;
+	}
+
+private:
+	refcounted* m_ptr;
+};
+
+namespace ztd { namespace out_ptr {
+	template <>
+	struct is_intrusive_handle<ref_handle> : std::true_type {};
+}} // namespace ztd::out_ptr
+
+#endif
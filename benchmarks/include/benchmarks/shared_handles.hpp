@@ -0,0 +1,31 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_SHARED_HANDLES_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_SHARED_HANDLES_HPP
+
+#include <ztd/out_ptr/shared_handle.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+// the shared_handle counterparts of a std::shared_ptr<ficapi::opaque> with a no-alloc deleter:
+// "atomic_count" may be shared between threads, "local_count" only within one
+using atomic_count_handle = ztd::out_ptr::basic_shared_handle<ficapi::opaque, decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+using local_count_handle
+	= ztd::out_ptr::basic_shared_handle<ficapi::opaque, decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete, ztd::out_ptr::local_count>;
+
+#endif
@@ -0,0 +1,42 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_THREADS_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_THREADS_HPP
+
+#include <cstddef>
+
+// the threaded benchmarks index fixed arrays of per-thread slots by thread_index(),
+// so more threads than this are never run
+constexpr const int benchmark_thread_slots = 256;
+
+// assumed by the padded layouts; true of every x86-64 and most AArch64 parts
+constexpr const std::size_t benchmark_cache_line_size = 64;
+
+// the largest thread count for ThreadRange: every hardware thread,
+// but at least 2 so that contention shows up even on a single core
+int max_benchmark_threads();
+
+// a per-thread value on a cache line of its own, so that the only sharing
+// between threads is the sharing a benchmark asks for
+template <typename T>
+struct alignas(benchmark_cache_line_size) padded {
+	T value;
+};
+
+#endif
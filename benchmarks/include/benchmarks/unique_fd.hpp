@@ -0,0 +1,91 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_UNIQUE_FD_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_UNIQUE_FD_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h>
+
+struct fd_deleter {
+	using pointer = int;
+
+	static void write_null(int& fd) noexcept {
+		fd = -1;
+	}
+
+	static bool is_null(const int& fd) noexcept {
+		return fd < 0;
+	}
+
+	void operator()(int fd) const noexcept {
+		::close(fd);
+	}
+};
+
+// the shape of a typical event loop's owning file descriptor:
+// one int, with its empty value and close() described by the deleter
+class unique_fd : private fd_deleter {
+public:
+	using pointer	  = int;
+	using deleter_type = fd_deleter;
+
+	unique_fd() noexcept
+	: m_fd(-1) {
+	}
+	explicit unique_fd(int fd) noexcept
+	: m_fd(fd) {
+	}
+	unique_fd(const unique_fd&) = delete;
+	unique_fd& operator=(const unique_fd&) = delete;
+	~unique_fd() {
+		this->reset();
+	}
+
+	int get() const noexcept {
+		return this->m_fd;
+	}
+
+	void reset(int fd = -1) noexcept {
+		if (!fd_deleter::is_null(this->m_fd)) {
+			this->get_deleter()(this->m_fd);
+		}
+		this->m_fd = fd;
+	}
+
+	int release() noexcept {
+		int fd	 = this->m_fd;
+		this->m_fd = -1;
+		return fd;
+	}
+
+	fd_deleter& get_deleter() noexcept {
+		return *this;
+	}
+
+	const fd_deleter& get_deleter() const noexcept {
+		return *this;
+	}
+
+private:
+	int m_fd;
+};
+
+#endif // POSIX
+
+#endif
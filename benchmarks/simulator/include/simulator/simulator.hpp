@@ -0,0 +1,84 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BENCHMARKS_SIMULATOR_HPP
+#define ZTD_OUT_PTR_BENCHMARKS_SIMULATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// A stand-in for the C libraries out_ptr is really used with. Unlike ficapi, calls fail some of
+// the time, may leave their output alone when they do, allocate, move on reallocation and take
+// a while to destroy things. Every behavior is set at runtime with sim_configure, and the calls
+// live in their own library so they cannot be inlined into the benchmarks.
+extern "C" {
+
+typedef struct sim_resource sim_resource;
+
+typedef struct sim_config {
+	// chance, from 0 to 1, that sim_create or sim_resize fails
+	double failure_rate;
+	// when non-zero, a failing call writes null to its output; sim_resize also frees its input.
+	// Otherwise the output is left as it was, and sim_resize keeps its input alive
+	int null_on_failure;
+	// bytes allocated, and written, for every resource
+	std::size_t allocation_size;
+	// chance, from 0 to 1, that a successful sim_resize moves the resource to a new allocation
+	double realloc_move_rate;
+	// time, in nanoseconds, that sim_destroy spins for before freeing a resource
+	std::uint32_t destroy_latency_ns;
+	// seeds the calling thread's random number generator, so runs are repeatable
+	std::uint64_t seed;
+} sim_config;
+
+// counts for the calling thread, since it was last configured
+typedef struct sim_stats {
+	std::uint64_t successes;
+	std::uint64_t failures;
+	std::uint64_t moves;
+	std::int64_t live;
+} sim_stats;
+
+void sim_default_config(sim_config* config);
+// not synchronized: configure before any thread starts calling in
+void sim_configure(const sim_config* config);
+void sim_get_stats(sim_stats* stats);
+
+// 0 on success, or non-zero on failure
+int sim_create(sim_resource** out);
+// two resources at once, like socketpair or a vendor's create_pair:
+// both are written, or the call fails. 0 on success, or non-zero on failure
+int sim_create_pair(sim_resource** first, sim_resource** second);
+// reallocates *inout (or creates a resource, if it is null), like realloc.
+// 0 on success, or non-zero on failure
+int sim_resize(sim_resource** inout);
+void sim_destroy(sim_resource* resource);
+// destroys n resources in one call, skipping null ones. The destroy latency is paid once for
+// the whole call, as a library which flushes or unmaps a whole pool at once does
+void sim_destroy_many(sim_resource* const* resources, std::size_t n);
+int sim_get_data(const sim_resource* resource);
+
+} // extern "C"
+
+struct sim_deleter {
+	void operator()(sim_resource* resource) const noexcept {
+		sim_destroy(resource);
+	}
+};
+
+#endif
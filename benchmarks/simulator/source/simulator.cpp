@@ -0,0 +1,229 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <simulator/simulator.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+struct sim_resource {
+	int data;
+	std::size_t size;
+};
+
+namespace {
+	constexpr const int resource_data = 0x1BADF00D;
+
+	sim_config current_config = { 0.0, 1, sizeof(sim_resource), 0.0, 0, 0x5EED };
+	// probabilities as thresholds for the top 32 bits of a random number, so a call does not
+	// need floating point to decide what to do
+	std::uint64_t failure_threshold = 0;
+	std::uint64_t move_threshold	= 0;
+
+	thread_local std::uint64_t rng_state = 0x5EED;
+	thread_local sim_stats current_stats = { 0, 0, 0, 0 };
+
+	std::uint64_t to_threshold(double rate) {
+		if (rate <= 0.0) {
+			return 0;
+		}
+		if (rate >= 1.0) {
+			return std::uint64_t(1) << 32;
+		}
+		return static_cast<std::uint64_t>(rate * 4294967296.0);
+	}
+
+	// xorshift64*: fast, and plenty random for picking outcomes
+	std::uint64_t next_random() {
+		std::uint64_t x = rng_state;
+		x ^= x >> 12;
+		x ^= x << 25;
+		x ^= x >> 27;
+		rng_state = x;
+		return (x * 0x2545F4914F6CDD1DULL) >> 32;
+	}
+
+	bool roll(std::uint64_t threshold) {
+		return threshold != 0 && next_random() < threshold;
+	}
+
+	std::size_t allocation_size() {
+		return current_config.allocation_size < sizeof(sim_resource) ? sizeof(sim_resource) : current_config.allocation_size;
+	}
+
+	sim_resource* allocate() {
+		std::size_t size = allocation_size();
+		void* memory	 = std::malloc(size);
+		if (memory == nullptr) {
+			return nullptr;
+		}
+		// real libraries initialize what they hand out
+		std::memset(memory, 0, size);
+		sim_resource* resource = static_cast<sim_resource*>(memory);
+		resource->data		   = resource_data;
+		resource->size		   = size;
+		++current_stats.live;
+		return resource;
+	}
+
+	void deallocate(sim_resource* resource) {
+		--current_stats.live;
+		std::free(resource);
+	}
+
+	void spin_destroy_latency() {
+		if (current_config.destroy_latency_ns == 0) {
+			return;
+		}
+		// stands in for flushing, closing or unmapping
+		std::chrono::steady_clock::time_point until
+			= std::chrono::steady_clock::now() + std::chrono::nanoseconds(current_config.destroy_latency_ns);
+		while (std::chrono::steady_clock::now() < until) {
+		}
+	}
+
+	int fail(sim_resource** out) {
+		++current_stats.failures;
+		if (current_config.null_on_failure != 0) {
+			*out = nullptr;
+		}
+		return 1;
+	}
+} // namespace
+
+extern "C" {
+
+void sim_default_config(sim_config* config) {
+	config->failure_rate	   = 0.0;
+	config->null_on_failure	   = 1;
+	config->allocation_size	   = sizeof(sim_resource);
+	config->realloc_move_rate  = 0.0;
+	config->destroy_latency_ns = 0;
+	config->seed			   = 0x5EED;
+}
+
+void sim_configure(const sim_config* config) {
+	current_config	  = *config;
+	failure_threshold = to_threshold(config->failure_rate);
+	move_threshold	  = to_threshold(config->realloc_move_rate);
+	// xorshift must never be seeded with 0
+	rng_state		  = config->seed != 0 ? config->seed : 0x5EED;
+	sim_stats live_only = { 0, 0, 0, current_stats.live };
+	current_stats	    = live_only;
+}
+
+void sim_get_stats(sim_stats* stats) {
+	*stats = current_stats;
+}
+
+int sim_create(sim_resource** out) {
+	if (roll(failure_threshold)) {
+		return fail(out);
+	}
+	sim_resource* resource = allocate();
+	if (resource == nullptr) {
+		return fail(out);
+	}
+	++current_stats.successes;
+	*out = resource;
+	return 0;
+}
+
+int sim_create_pair(sim_resource** first, sim_resource** second) {
+	if (roll(failure_threshold)) {
+		if (current_config.null_on_failure != 0) {
+			*first = nullptr;
+		}
+		return fail(second);
+	}
+	sim_resource* first_resource = allocate();
+	if (first_resource == nullptr) {
+		if (current_config.null_on_failure != 0) {
+			*first = nullptr;
+		}
+		return fail(second);
+	}
+	sim_resource* second_resource = allocate();
+	if (second_resource == nullptr) {
+		deallocate(first_resource);
+		if (current_config.null_on_failure != 0) {
+			*first = nullptr;
+		}
+		return fail(second);
+	}
+	++current_stats.successes;
+	*first  = first_resource;
+	*second = second_resource;
+	return 0;
+}
+
+int sim_resize(sim_resource** inout) {
+	sim_resource* resource = *inout;
+	if (resource == nullptr) {
+		return sim_create(inout);
+	}
+	if (roll(failure_threshold)) {
+		if (current_config.null_on_failure != 0) {
+			sim_destroy(resource);
+		}
+		return fail(inout);
+	}
+	if (roll(move_threshold)) {
+		sim_resource* moved = allocate();
+		if (moved == nullptr) {
+			return fail(inout);
+		}
+		std::memcpy(moved, resource, resource->size < moved->size ? resource->size : moved->size);
+		moved->size = allocation_size();
+		deallocate(resource);
+		++current_stats.moves;
+		resource = moved;
+	}
+	else {
+		// grown in place: nothing to copy
+		resource->data = resource_data;
+	}
+	++current_stats.successes;
+	*inout = resource;
+	return 0;
+}
+
+void sim_destroy(sim_resource* resource) {
+	if (resource == nullptr) {
+		return;
+	}
+	spin_destroy_latency();
+	deallocate(resource);
+}
+
+void sim_destroy_many(sim_resource* const* resources, std::size_t n) {
+	if (n == 0) {
+		return;
+	}
+	spin_destroy_latency();
+	for (std::size_t i = 0; i < n; ++i) {
+		if (resources[i] != nullptr) {
+			deallocate(resources[i]);
+		}
+	}
+}
+
+int sim_get_data(const sim_resource* resource) {
+	return resource->data;
+}
+
+} // extern "C"
@@ -0,0 +1,149 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/perf_counters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/batch_out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <cstddef>
+
+// ficapi has no "create_many(size_t n, T** out_array)"-style function,
+// so stand one up on top of the DLL-hidden single-handle creation function
+static void ficapi_handle_no_alloc_create_many(std::size_t n, ficapi_opaque_handle* out_array) {
+	for (std::size_t i = 0; i < n; ++i) {
+		ficapi_handle_no_alloc_create(out_array + i);
+	}
+}
+
+static void c_code_batch_out_ptr(benchmark::State& state) {
+	const std::size_t n = static_cast<std::size_t>(state.range(0));
+	int64_t x		    = 0;
+	std::vector<ficapi_opaque_handle> handles(n, nullptr);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create_many(n, handles.data());
+		for (std::size_t i = 0; i < n; ++i) {
+			x += ficapi_handle_get_data(handles[i]);
+			ficapi_handle_no_alloc_delete(handles[i]);
+		}
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * int64_t(n) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(c_code_batch_out_ptr)
+	->RangeMultiplier(8)
+	->Range(1, 65536)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_batch_out_ptr(benchmark::State& state) {
+	const std::size_t n = static_cast<std::size_t>(state.range(0));
+	int64_t x		    = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::vector<std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter>> handles(n);
+		std::vector<ficapi_opaque_handle> temp_handles(n, nullptr);
+		ficapi_handle_no_alloc_create_many(n, temp_handles.data());
+		for (std::size_t i = 0; i < n; ++i) {
+			handles[i].reset(temp_handles[i]);
+		}
+		for (const auto& p : handles) {
+			x += ficapi_handle_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * int64_t(n) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(manual_batch_out_ptr)
+	->RangeMultiplier(8)
+	->Range(1, 65536)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void out_ptr_batch_out_ptr(benchmark::State& state) {
+	const std::size_t n = static_cast<std::size_t>(state.range(0));
+	int64_t x		    = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::vector<std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter>> handles(n);
+		for (auto& p : handles) {
+			ficapi_handle_no_alloc_create_many(1, ztd::out_ptr::out_ptr(p));
+		}
+		for (const auto& p : handles) {
+			x += ficapi_handle_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * int64_t(n) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(out_ptr_batch_out_ptr)
+	->RangeMultiplier(8)
+	->Range(1, 65536)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void batch_batch_out_ptr(benchmark::State& state) {
+	const std::size_t n = static_cast<std::size_t>(state.range(0));
+	int64_t x		    = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::vector<std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter>> handles;
+		ficapi_handle_no_alloc_create_many(n, ztd::out_ptr::batch_out_ptr(handles, n));
+		for (const auto& p : handles) {
+			x += ficapi_handle_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * int64_t(n) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(batch_batch_out_ptr)
+	->RangeMultiplier(8)
+	->Range(1, 65536)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
@@ -0,0 +1,85 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/perf_counters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <cstdlib>
+
+// the same stateless deleter, except that a user-provided copy constructor
+// keeps it from being trivially copyable, so the adaptor holds a reference to it
+struct referenced_no_alloc_deleter {
+	referenced_no_alloc_deleter() noexcept {
+	}
+	referenced_no_alloc_deleter(const referenced_no_alloc_deleter&) noexcept {
+	}
+
+	void operator()(ficapi_opaque_handle p) const {
+		ficapi_handle_no_alloc_delete(p);
+	}
+};
+
+static void reference_compressed_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	referenced_no_alloc_deleter deleter;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::unique_ptr<ficapi::opaque, referenced_no_alloc_deleter> p(nullptr, deleter);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, deleter));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	state.counters["adaptor_bytes"] = static_cast<double>(sizeof(ztd::out_ptr::out_ptr_t<std::unique_ptr<ficapi::opaque, referenced_no_alloc_deleter>, ficapi_opaque_handle, referenced_no_alloc_deleter&>));
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(reference_compressed_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void value_compressed_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	ficapi::handle_no_alloc_deleter deleter;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr, deleter);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, deleter));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	state.counters["adaptor_bytes"] = static_cast<double>(sizeof(ztd::out_ptr::out_ptr_t<std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter>, ficapi_opaque_handle, ficapi::handle_no_alloc_deleter&>));
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(value_compressed_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
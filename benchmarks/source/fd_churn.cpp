@@ -0,0 +1,148 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/unique_fd.hpp>
+#include <benchmarks/perf_counters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// the "clever" variant measures the opt-in integral path
+#define ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR 1
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/array_out_ptr.hpp>
+
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+// each iteration opens a pipe and an event descriptor over the ones from the previous iteration,
+// which is what an event loop re-arming its wakeup channels does all day long
+namespace {
+	int open_event_fd(int* out) {
+#if defined(__linux__)
+		int fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#else
+		int fd = -1;
+		int ends[2];
+		if (::pipe(ends) == 0) {
+			::close(ends[1]);
+			fd = ends[0];
+		}
+#endif
+		if (fd < 0) {
+			return -1;
+		}
+		*out = fd;
+		return 0;
+	}
+} // namespace
+
+static void c_code_fd_churn(benchmark::State& state) {
+	int ends[2] = { -1, -1 };
+	int event	  = -1;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (ends[0] != -1) {
+			::close(ends[0]);
+			::close(ends[1]);
+		}
+		if (event != -1) {
+			::close(event);
+		}
+		if (::pipe(ends) != 0 || open_event_fd(&event) != 0) {
+			state.SkipWithError("could not open file descriptors");
+			return;
+		}
+	}
+	counters.report(state);
+	::close(ends[0]);
+	::close(ends[1]);
+	::close(event);
+}
+BENCHMARK(c_code_fd_churn)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_fd_churn(benchmark::State& state) {
+	unique_fd ends[2];
+	unique_fd event;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		int temp_ends[2] = { -1, -1 };
+		int temp_event	  = -1;
+		if (::pipe(temp_ends) != 0 || open_event_fd(&temp_event) != 0) {
+			state.SkipWithError("could not open file descriptors");
+			return;
+		}
+		ends[0].reset(temp_ends[0]);
+		ends[1].reset(temp_ends[1]);
+		event.reset(temp_event);
+	}
+	counters.report(state);
+}
+BENCHMARK(manual_fd_churn)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void simple_fd_churn(benchmark::State& state) {
+	unique_fd ends[2];
+	unique_fd event;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (::pipe(ztd::out_ptr::op_detail::simple_array_out_ptr(ends)) != 0 || open_event_fd(ztd::out_ptr::op_detail::simple_out_ptr(event)) != 0) {
+			state.SkipWithError("could not open file descriptors");
+			return;
+		}
+	}
+	counters.report(state);
+}
+BENCHMARK(simple_fd_churn)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void clever_fd_churn(benchmark::State& state) {
+	unique_fd ends[2];
+	unique_fd event;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (::pipe(ztd::out_ptr::array_out_ptr(ends)) != 0 || open_event_fd(ztd::out_ptr::out_ptr(event)) != 0) {
+			state.SkipWithError("could not open file descriptors");
+			return;
+		}
+	}
+	counters.report(state);
+}
+BENCHMARK(clever_fd_churn)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+#endif // POSIX
@@ -0,0 +1,122 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/refcounted.hpp>
+#include <benchmarks/perf_counters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+static void c_code_intrusive_out_ptr(benchmark::State& state) {
+	int64_t x	    = 0;
+	refcounted* p = NULL;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (p != NULL) {
+			refcounted_release(p);
+		}
+		void* temp_p = NULL;
+		refcounted_create(&temp_p);
+		p = static_cast<refcounted*>(temp_p);
+		x += refcounted_get_data(p);
+	}
+	counters.report(state);
+	if (p != NULL) {
+		refcounted_release(p);
+	}
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(c_code_intrusive_out_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_intrusive_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	ref_handle p(nullptr);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		void* temp_p = NULL;
+		refcounted_create(&temp_p);
+		p.reset(static_cast<refcounted*>(temp_p), false);
+		x += refcounted_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(manual_intrusive_out_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void simple_intrusive_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	ref_handle p(nullptr);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		refcounted_create(ztd::out_ptr::op_detail::simple_out_ptr<void*>(p, false));
+		x += refcounted_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(simple_intrusive_out_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void clever_intrusive_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	ref_handle p(nullptr);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		refcounted_create(ztd::out_ptr::op_detail::clever_out_ptr<void*>(p, false));
+		x += refcounted_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(clever_intrusive_out_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
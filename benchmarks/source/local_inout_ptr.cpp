@@ -23,14 +23,22 @@
 #include <benchmarks/out_ptr/friendly_unique_ptr.hpp>
 #include <ztd/out_ptr/inout_ptr.hpp>
 #include <benchmarks/out_ptr/friendly_inout_ptr.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/pool_counter.hpp>
+#include <ztd/out_ptr/pooled_handle.hpp>
 
 #include <ficapi/ficapi.hpp>
 
 #include <memory>
 #include <cstdlib>
 
+// releasing a handle keeps it for the next re-create instead of destroying it
+using no_alloc_pool		 = ztd::out_ptr::handle_pool<decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+using pooled_no_alloc_handle = ztd::out_ptr::basic_pooled_handle<ficapi::opaque, decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+
 static void c_code_local_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_opaque_handle p = NULL;
@@ -38,6 +46,7 @@ static void c_code_local_inout_ptr(benchmark::State& state) {
 		x += ficapi_handle_get_data(p);
 		ficapi_handle_no_alloc_delete(p);
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -52,6 +61,7 @@ BENCHMARK(c_code_local_inout_ptr)
 
 static void manual_local_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
@@ -60,6 +70,7 @@ static void manual_local_inout_ptr(benchmark::State& state) {
 		p.reset(temp_p);
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -74,12 +85,14 @@ BENCHMARK(manual_local_inout_ptr)
 
 static void simple_local_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
 		ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::simple_inout_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -94,12 +107,14 @@ BENCHMARK(simple_local_inout_ptr)
 
 static void clever_local_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
 		ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -112,16 +127,45 @@ BENCHMARK(clever_local_inout_ptr)
 	->ComputeStatistics("min", &compute_min)
 	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
 
+static void handle_pool_local_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	no_alloc_pool::drain();
+	pool_tally<no_alloc_pool> pool;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		// the handle goes back to the pool at the end of each iteration, and the next one re-creates into it
+		pooled_no_alloc_handle p(nullptr);
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	pool.report(state);
+	no_alloc_pool::drain();
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(handle_pool_local_inout_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
 #if defined(ZTD_OUT_PTR_HAS_FRIENDLY_UNIQUE_PTR) && ZTD_OUT_PTR_HAS_FRIENDLY_UNIQUE_PTR != 0
 
 static void friendly_local_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::friendly_unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
 		ficapi_handle_no_alloc_re_create(ztd::out_ptr::friendly_inout_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
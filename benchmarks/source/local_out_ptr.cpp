@@ -23,6 +23,7 @@
 #include <benchmarks/out_ptr/friendly_unique_ptr.hpp>
 #include <ztd/out_ptr/out_ptr.hpp>
 #include <benchmarks/out_ptr/friendly_out_ptr.hpp>
+#include <benchmarks/perf_counters.hpp>
 
 #include <ficapi/ficapi.hpp>
 
@@ -31,6 +32,7 @@
 
 static void c_code_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_opaque_handle p = NULL;
@@ -38,6 +40,7 @@ static void c_code_local_out_ptr(benchmark::State& state) {
 		x += ficapi_handle_get_data(p);
 		ficapi_handle_no_alloc_delete(p);
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -51,6 +54,7 @@ BENCHMARK(c_code_local_out_ptr)
 
 static void manual_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
@@ -60,6 +64,7 @@ static void manual_local_out_ptr(benchmark::State& state) {
 		p.reset(temp_p);
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -73,12 +78,14 @@ BENCHMARK(manual_local_out_ptr)
 
 static void simple_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
 		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::simple_out_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -92,12 +99,14 @@ BENCHMARK(simple_local_out_ptr)
 
 static void clever_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
 		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -113,12 +122,14 @@ BENCHMARK(clever_local_out_ptr)
 
 static void friendly_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::friendly_unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
 		ficapi_handle_no_alloc_create(ztd::out_ptr::friendly_out_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
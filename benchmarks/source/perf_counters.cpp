@@ -0,0 +1,149 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/statistics.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <atomic>
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+	struct perf_event_kind {
+		const char* name;
+		std::uint32_t type;
+		std::uint64_t config;
+	};
+
+	constexpr std::uint64_t cache_read_misses(std::uint64_t cache) {
+		return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	}
+
+	// "cycles" must stay first: it decides whether the time stamp counter stands in for it
+	const perf_event_kind perf_events[perf_event_count] = {
+		{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ "branches", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+		{ "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		{ "l1d_misses", PERF_TYPE_HW_CACHE, cache_read_misses(PERF_COUNT_HW_CACHE_L1D) },
+		{ "l1i_misses", PERF_TYPE_HW_CACHE, cache_read_misses(PERF_COUNT_HW_CACHE_L1I) },
+	};
+
+	int open_perf_event(const perf_event_kind& kind) noexcept {
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size	 = sizeof(attr);
+		attr.type	 = kind.type;
+		attr.config = kind.config;
+		attr.disabled = 1;
+		// user space only: it is all that is allowed at the default perf_event_paranoid,
+		// and the adaptors never enter the kernel themselves
+		attr.exclude_kernel = 1;
+		attr.exclude_hv	= 1;
+		// more events than the PMU has counters are multiplexed: scaled back up in report()
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		// this thread only, on whichever CPU it runs
+		return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+
+	std::atomic<bool> unavailable_warned(false);
+
+	void warn_unavailable(const perf_event_kind& kind, int error) {
+		if (unavailable_warned.exchange(true)) {
+			return;
+		}
+		std::fprintf(stderr,
+			"ztd.out_ptr.benchmarks: the \"%s\" performance counter is unavailable (perf_event_open: %s); "
+			"it and any other unavailable counter will not be reported\n",
+			kind.name, std::strerror(error));
+	}
+} // namespace
+
+perf_tally::perf_tally() noexcept
+: m_fds(), m_tsc_start(0) {
+	for (std::size_t i = 0; i < perf_event_count; ++i) {
+		this->m_fds[i] = open_perf_event(perf_events[i]);
+		if (this->m_fds[i] < 0) {
+			warn_unavailable(perf_events[i], errno);
+		}
+	}
+	for (std::size_t i = 0; i < perf_event_count; ++i) {
+		if (this->m_fds[i] >= 0) {
+			::ioctl(this->m_fds[i], PERF_EVENT_IOC_RESET, 0);
+			::ioctl(this->m_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+	this->m_tsc_start = rdtsc();
+}
+
+perf_tally::~perf_tally() {
+	for (std::size_t i = 0; i < perf_event_count; ++i) {
+		if (this->m_fds[i] >= 0) {
+			::close(this->m_fds[i]);
+		}
+	}
+}
+
+void perf_tally::report(benchmark::State& state) {
+	std::uint64_t tsc_end = rdtsc();
+	for (std::size_t i = 0; i < perf_event_count; ++i) {
+		if (this->m_fds[i] >= 0) {
+			::ioctl(this->m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	for (std::size_t i = 0; i < perf_event_count; ++i) {
+		if (this->m_fds[i] < 0) {
+			if (i == 0) {
+				state.counters["tsc_cycles"] = benchmark::Counter(static_cast<double>(tsc_end - this->m_tsc_start), benchmark::Counter::kAvgIterations);
+			}
+			continue;
+		}
+		// { value, time_enabled, time_running }
+		std::uint64_t values[3] = {};
+		if (::read(this->m_fds[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) {
+			continue;
+		}
+		double count = static_cast<double>(values[0]);
+		if (values[2] < values[1]) {
+			count *= static_cast<double>(values[1]) / static_cast<double>(values[2]);
+		}
+		state.counters[perf_events[i].name] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+	}
+}
+
+#else
+
+perf_tally::perf_tally() noexcept
+: m_fds(), m_tsc_start(rdtsc()) {
+}
+
+perf_tally::~perf_tally() {
+}
+
+void perf_tally::report(benchmark::State& state) {
+	std::uint64_t tsc_end = rdtsc();
+	state.counters["tsc_cycles"] = benchmark::Counter(static_cast<double>(tsc_end - this->m_tsc_start), benchmark::Counter::kAvgIterations);
+}
+
+#endif
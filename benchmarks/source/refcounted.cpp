@@ -0,0 +1,47 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <benchmarks/refcounted.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+struct refcounted {
+	int refs;
+	int data;
+};
+
+namespace {
+	thread_local refcounted the_object = { 0, 0 };
+}
+
+int refcounted_create(void** out) {
+	refcounted& object = the_object;
+	object.data		= ficapi_get_data();
+	++object.refs;
+	*out = &object;
+	return 0;
+}
+
+void refcounted_add_ref(refcounted* p) {
+	++p->refs;
+}
+
+void refcounted_release(refcounted* p) {
+	--p->refs;
+}
+
+int refcounted_get_data(const refcounted* p) {
+	return p->data;
+}
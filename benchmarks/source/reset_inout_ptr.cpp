@@ -21,20 +21,29 @@
 #include <benchmarks/out_ptr/friendly_unique_ptr.hpp>
 #include <ztd/out_ptr/inout_ptr.hpp>
 #include <benchmarks/out_ptr/friendly_inout_ptr.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/pool_counter.hpp>
+#include <ztd/out_ptr/pooled_handle.hpp>
 
 #include <ficapi/ficapi.hpp>
 
 #include <memory>
 #include <cstdlib>
 
+// releasing a handle keeps it for the next re-create instead of destroying it
+using no_alloc_pool		 = ztd::out_ptr::handle_pool<decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+using pooled_no_alloc_handle = ztd::out_ptr::basic_pooled_handle<ficapi::opaque, decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+
 static void c_code_reset_inout_ptr(benchmark::State& state) {
 	int64_t x			   = 0;
 	ficapi_opaque_handle p = NULL;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_re_create(&p);
 		x += ficapi_handle_get_data(p);
 	}
+	counters.report(state);
 	if (p != NULL) {
 		ficapi_handle_no_alloc_delete(p);
 	}
@@ -48,6 +57,7 @@ BENCHMARK(c_code_reset_inout_ptr)
 static void manual_reset_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_opaque_handle temp_p = p.release();
@@ -55,6 +65,7 @@ static void manual_reset_inout_ptr(benchmark::State& state) {
 		p.reset(temp_p);
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -70,11 +81,13 @@ BENCHMARK(manual_reset_inout_ptr)
 static void simple_reset_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::simple_inout_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -90,11 +103,13 @@ BENCHMARK(simple_reset_inout_ptr)
 static void clever_reset_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -108,16 +123,45 @@ BENCHMARK(clever_reset_inout_ptr)
 	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
 
 
+static void handle_pool_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	no_alloc_pool::drain();
+	pool_tally<no_alloc_pool> pool;
+	pooled_no_alloc_handle p(nullptr);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	pool.report(state);
+	no_alloc_pool::drain();
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(handle_pool_reset_inout_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
 #if defined(ZTD_OUT_PTR_HAS_FRIENDLY_UNIQUE_PTR) && ZTD_OUT_PTR_HAS_FRIENDLY_UNIQUE_PTR != 0
 
 static void friendly_reset_inout_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::friendly_unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_re_create(ztd::out_ptr::friendly_inout_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
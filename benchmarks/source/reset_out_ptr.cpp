@@ -23,6 +23,7 @@
 #include <benchmarks/out_ptr/friendly_unique_ptr.hpp>
 #include <ztd/out_ptr/out_ptr.hpp>
 #include <benchmarks/out_ptr/friendly_out_ptr.hpp>
+#include <benchmarks/perf_counters.hpp>
 
 #include <ficapi/ficapi.hpp>
 
@@ -32,6 +33,7 @@
 static void c_code_reset_out_ptr(benchmark::State& state) {
 	int64_t x			   = 0;
 	ficapi_opaque_handle p = NULL;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		if (p != NULL) {
@@ -40,6 +42,7 @@ static void c_code_reset_out_ptr(benchmark::State& state) {
 		ficapi_handle_no_alloc_create(&p);
 		x += ficapi_handle_get_data(p);
 	}
+	counters.report(state);
 	if (p != NULL) {
 		ficapi_handle_no_alloc_delete(p);
 	}
@@ -53,6 +56,7 @@ BENCHMARK(c_code_reset_out_ptr)
 static void manual_reset_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_opaque_handle temp_p = NULL;
@@ -60,6 +64,7 @@ static void manual_reset_out_ptr(benchmark::State& state) {
 		p.reset(temp_p);
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -75,11 +80,13 @@ BENCHMARK(manual_reset_out_ptr)
 static void simple_reset_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::simple_out_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -95,11 +102,13 @@ BENCHMARK(simple_reset_out_ptr)
 static void clever_reset_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -112,17 +121,41 @@ BENCHMARK(clever_reset_out_ptr)
 	->ComputeStatistics("min", &compute_min)
 	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
 
+static void prenull_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(prenull_reset_out_ptr)
+
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
 
 #if defined(ZTD_OUT_PTR_HAS_FRIENDLY_UNIQUE_PTR) && ZTD_OUT_PTR_HAS_FRIENDLY_UNIQUE_PTR != 0
 
 static void friendly_reset_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::friendly_unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter> p(nullptr);
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_create(ztd::out_ptr::friendly_out_ptr(p));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
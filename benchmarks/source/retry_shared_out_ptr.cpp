@@ -0,0 +1,209 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/shared_handles.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/lazy_arg.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <cstdlib>
+
+// an acquisition API which fails every other call and, like most, outputs null when it does
+static int ficapi_handle_no_alloc_create_flaky(ficapi_opaque_handle* out, int attempt) {
+	if ((attempt % 2) == 0) {
+		*out = NULL;
+		return 1;
+	}
+	ficapi_handle_no_alloc_create(out);
+	return 0;
+}
+
+static void manual_retry_shared_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	int attempt = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create_flaky(&temp_p, attempt);
+		p.reset(temp_p, ficapi::handle_no_alloc_deleter());
+		if (p != nullptr) {
+			x += ficapi_handle_get_data(p.get());
+		}
+		++attempt;
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations() / 2) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(manual_retry_shared_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_checked_retry_shared_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	int attempt = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		if (ficapi_handle_no_alloc_create_flaky(&temp_p, attempt) == 0) {
+			p.reset(temp_p, ficapi::handle_no_alloc_deleter());
+		}
+		else {
+			p.reset();
+		}
+		if (p != nullptr) {
+			x += ficapi_handle_get_data(p.get());
+		}
+		++attempt;
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations() / 2) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(manual_checked_retry_shared_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void out_ptr_retry_shared_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	int attempt = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create_flaky(ztd::out_ptr::out_ptr(p, ficapi::handle_no_alloc_deleter()), attempt);
+		if (p != nullptr) {
+			x += ficapi_handle_get_data(p.get());
+		}
+		++attempt;
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations() / 2) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(out_ptr_retry_shared_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void lazy_retry_shared_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	int attempt = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create_flaky(ztd::out_ptr::out_ptr(p, ztd::out_ptr::lazy_arg([]() { return ficapi::handle_no_alloc_deleter(); })), attempt);
+		if (p != nullptr) {
+			x += ficapi_handle_get_data(p.get());
+		}
+		++attempt;
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations() / 2) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(lazy_retry_shared_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_count_retry_shared_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	int attempt = 0;
+	atomic_count_handle p;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create_flaky(ztd::out_ptr::out_ptr(p), attempt);
+		if (p) {
+			x += ficapi_handle_get_data(p.get());
+		}
+		++attempt;
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations() / 2) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(atomic_count_retry_shared_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void local_count_retry_shared_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	int attempt = 0;
+	local_count_handle p;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create_flaky(ztd::out_ptr::out_ptr(p), attempt);
+		if (p) {
+			x += ficapi_handle_get_data(p.get());
+		}
+		++attempt;
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations() / 2) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(local_count_retry_shared_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
@@ -0,0 +1,125 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/aliasing_out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <cstdlib>
+
+namespace {
+	// stands in for a C function that hands out memory owned by its argument, like a
+	// statement owned by its connection or a row owned by its result set: the output is only
+	// valid while the parent is alive, and must never be freed on its own
+	void ficapi_handle_view(ficapi_opaque_handle parent, ficapi_opaque_handle* out) {
+		benchmark::DoNotOptimize(parent);
+		*out = parent;
+	}
+
+	struct noop_deleter {
+		void operator()(ficapi_opaque_handle) const noexcept {
+		}
+	};
+
+	std::shared_ptr<ficapi::opaque> make_parent() {
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create(&temp_p);
+		return std::shared_ptr<ficapi::opaque>(temp_p, ficapi::handle_no_alloc_deleter());
+	}
+} // namespace
+
+// the workaround in use today: the child gets a control block of its own with a deleter
+// that does nothing, so every commit allocates, and nothing keeps the parent alive
+static void noop_deleter_shared_alias_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> parent = make_parent();
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::shared_ptr<ficapi::opaque> child;
+		ficapi_handle_view(parent.get(), ztd::out_ptr::out_ptr(child, noop_deleter()));
+		x += ficapi_handle_get_data(child.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(noop_deleter_shared_alias_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_shared_alias_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> parent = make_parent();
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_view(parent.get(), &temp_p);
+		std::shared_ptr<ficapi::opaque> child(parent, temp_p);
+		x += ficapi_handle_get_data(child.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(manual_shared_alias_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void aliasing_shared_alias_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> parent = make_parent();
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::shared_ptr<ficapi::opaque> child;
+		ficapi_handle_view(parent.get(), ztd::out_ptr::aliasing_out_ptr(child, parent));
+		x += ficapi_handle_get_data(child.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(aliasing_shared_alias_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
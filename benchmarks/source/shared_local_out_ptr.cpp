@@ -1,8 +1,12 @@
 #include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/shared_handles.hpp>
 
 #include <benchmark/benchmark.h>
 
 #include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
 
 #include <ficapi/ficapi.hpp>
 
@@ -33,6 +37,8 @@ std::shared_ptr<ficapi::opaque> out_ptr_shared_allocate() {
 
 static void manual_inline_shared_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
@@ -42,6 +48,8 @@ static void manual_inline_shared_local_out_ptr(benchmark::State& state) {
 		p.reset(temp_p, ficapi::handle_no_alloc_deleter());
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -55,6 +63,8 @@ BENCHMARK(manual_inline_shared_local_out_ptr)
 
 static void manual_inline_no_reset_shared_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_opaque_handle temp_p = NULL;
@@ -63,6 +73,8 @@ static void manual_inline_no_reset_shared_local_out_ptr(benchmark::State& state)
 
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -77,11 +89,15 @@ BENCHMARK(manual_inline_no_reset_shared_local_out_ptr)
 
 static void manual_rvo_shared_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::shared_ptr<ficapi::opaque> p = rvo_shared_allocate();
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -96,11 +112,15 @@ BENCHMARK(manual_rvo_shared_local_out_ptr)
 
 static void manual_return_shared_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::shared_ptr<ficapi::opaque> p = shared_allocate();
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -114,11 +134,15 @@ BENCHMARK(manual_return_shared_local_out_ptr)
 
 static void return_out_ptr_shared_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::shared_ptr<ficapi::opaque> p = out_ptr_shared_allocate();
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -132,12 +156,16 @@ BENCHMARK(return_out_ptr_shared_local_out_ptr)
 
 static void inline_out_ptr_shared_local_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
 		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p, ficapi::handle_no_alloc_deleter()));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -148,3 +176,72 @@ BENCHMARK(inline_out_ptr_shared_local_out_ptr)
 	->ComputeStatistics("max", &compute_max)
 	->ComputeStatistics("min", &compute_min)
 	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void preallocated_out_ptr_shared_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::shared_ptr<ficapi::opaque> p(nullptr);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(preallocated_out_ptr_shared_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_count_shared_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		atomic_count_handle p;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(atomic_count_shared_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void local_count_shared_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		local_count_handle p;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(local_count_shared_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
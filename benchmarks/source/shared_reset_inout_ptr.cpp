@@ -0,0 +1,129 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/shared_handles.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <cstdlib>
+
+// inout_ptr itself does not take a std::shared_ptr, so this is what re-creating a shared
+// handle looks like without recycling_inout_ptr: the re-created handle gets a new control
+// block, while the old block's deleter still runs on the old handle. That is only correct
+// because ficapi's no_alloc handles are never freed; it stands in for the allocation every
+// re-create pays today
+static void manual_shared_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = p.get();
+		ficapi_handle_no_alloc_re_create(&temp_p);
+		p.reset(temp_p, ficapi::handle_no_alloc_deleter());
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(manual_shared_reset_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void recycling_shared_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::recycling_inout_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(recycling_shared_reset_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_count_shared_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	atomic_count_handle p;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(atomic_count_shared_reset_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void local_count_shared_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	local_count_handle p;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(local_count_shared_reset_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
@@ -15,10 +15,15 @@
 //  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
 
 #include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/shared_handles.hpp>
 
 #include <benchmark/benchmark.h>
 
 #include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+#include <ztd/out_ptr/thread_pooled_allocator.hpp>
 
 #include <ficapi/ficapi.hpp>
 
@@ -29,6 +34,8 @@
 static void manual_shared_reset_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_opaque_handle temp_p = NULL;
@@ -36,6 +43,8 @@ static void manual_shared_reset_out_ptr(benchmark::State& state) {
 		p.reset(temp_p, ficapi::handle_no_alloc_deleter());
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -50,11 +59,15 @@ BENCHMARK(manual_shared_reset_out_ptr)
 static void out_ptr_shared_reset_out_ptr(benchmark::State& state) {
 	int64_t x = 0;
 	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	allocation_tally allocations;
+	perf_tally counters;
 	for (auto _ : state) {
 		(void)_;
 		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p, ficapi::handle_no_alloc_deleter()));
 		x += ficapi_handle_get_data(p.get());
 	}
+	counters.report(state);
+	allocations.report(state);
 	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
 	if (x != expected) {
 		state.SkipWithError("Unexpected result");
@@ -65,3 +78,119 @@ BENCHMARK(out_ptr_shared_reset_out_ptr)
 	->ComputeStatistics("max", &compute_max)
 	->ComputeStatistics("min", &compute_min)
 	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void pooled_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	ztd::out_ptr::thread_pooled_allocator<ficapi::opaque> alloc;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, ficapi::handle_no_alloc_deleter(), alloc));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(pooled_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void preallocated_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(preallocated_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void recycling_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	std::shared_ptr<ficapi::opaque> p(nullptr, ficapi::handle_no_alloc_deleter());
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::recycling_out_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(recycling_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_count_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	atomic_count_handle p;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(atomic_count_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void local_count_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	local_count_handle p;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(local_count_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
@@ -0,0 +1,804 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/pool_counter.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/ownership_policy.hpp>
+#include <ztd/out_ptr/out_ptrs.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+#include <ztd/out_ptr/pooled_handle.hpp>
+#include <ztd/out_ptr/arena_handle.hpp>
+#include <ztd/out_ptr/shared_handle.hpp>
+
+#include <simulator/simulator.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// Whole-call benchmarks against the simulated C library, rather than ficapi's ideal one.
+// Each variant runs under several named "mixes" of failures, reallocation moves,
+// allocation sizes and destroy latencies, so the cost of each adaptor shows up next to
+// what a real C call costs, and on the failure paths as well as the happy one
+
+namespace {
+	sim_config make_mix(double failure_rate, int null_on_failure, std::size_t allocation_size, double realloc_move_rate, std::uint32_t destroy_latency_ns) {
+		sim_config config;
+		sim_default_config(&config);
+		config.failure_rate		  = failure_rate;
+		config.null_on_failure	  = null_on_failure;
+		config.allocation_size	  = allocation_size;
+		config.realloc_move_rate  = realloc_move_rate;
+		config.destroy_latency_ns = destroy_latency_ns;
+		return config;
+	}
+
+	// sim_create
+	const sim_config ideal_mix			 = make_mix(0.0, 1, 16, 0.0, 0);
+	const sim_config flaky_null_mix	 = make_mix(0.25, 1, 16, 0.0, 0);
+	const sim_config flaky_unchanged_mix = make_mix(0.25, 0, 16, 0.0, 0);
+	const sim_config large_mix			 = make_mix(0.05, 1, 4096, 0.0, 0);
+	const sim_config slow_destroy_mix	 = make_mix(0.05, 1, 16, 0.0, 250);
+
+	// sim_resize
+	const sim_config in_place_mix				= make_mix(0.0, 1, 16, 0.0, 0);
+	const sim_config moving_mix				= make_mix(0.0, 1, 16, 1.0, 0);
+	const sim_config flaky_null_resize_mix		= make_mix(0.1, 1, 16, 0.5, 0);
+	const sim_config flaky_unchanged_resize_mix = make_mix(0.1, 0, 16, 0.5, 0);
+	const sim_config large_resize_mix			= make_mix(0.05, 1, 4096, 0.5, 0);
+
+	// sim_resize into a handle which is dropped every iteration
+	const sim_config churn_mix				  = make_mix(0.0, 1, 16, 0.0, 0);
+	const sim_config large_churn_mix		  = make_mix(0.0, 1, 4096, 0.0, 0);
+	const sim_config slow_destroy_churn_mix = make_mix(0.0, 1, 16, 0.0, 250);
+	const sim_config moving_churn_mix		  = make_mix(0.05, 1, 16, 1.0, 0);
+
+	using sim_pool		   = ztd::out_ptr::handle_pool<decltype(&sim_destroy), &sim_destroy>;
+	using pooled_sim_handle = ztd::out_ptr::basic_pooled_handle<sim_resource, decltype(&sim_destroy), &sim_destroy>;
+
+	using atomic_count_sim_handle = ztd::out_ptr::basic_shared_handle<sim_resource, decltype(&sim_destroy), &sim_destroy>;
+	using local_count_sim_handle  = ztd::out_ptr::basic_shared_handle<sim_resource, decltype(&sim_destroy), &sim_destroy, ztd::out_ptr::local_count>;
+
+	using sim_arena		   = ztd::out_ptr::handle_arena<sim_resource*, ztd::out_ptr::basic_batch_destroy<decltype(&sim_destroy_many), &sim_destroy_many>>;
+	using sim_arena_handle = ztd::out_ptr::arena_handle<sim_arena>;
+
+	struct simulation {
+		sim_stats start;
+
+		simulation(const sim_config& mix) {
+			sim_configure(&mix);
+			sim_get_stats(&start);
+		}
+
+		// reports how often the C calls failed and moved, and checks that every resource was
+		// destroyed once the handle is gone. `observed` is the number of successful results seen
+		// in the handle, or -1 when that cannot be known from the outside
+		void report(benchmark::State& state, std::int64_t observed) const {
+			sim_stats end;
+			sim_get_stats(&end);
+			state.counters["failures"] = benchmark::Counter(static_cast<double>(end.failures), benchmark::Counter::kAvgIterations);
+			state.counters["moves"]	   = benchmark::Counter(static_cast<double>(end.moves), benchmark::Counter::kAvgIterations);
+			if (end.live != start.live) {
+				state.SkipWithError("Leaked or double-destroyed a resource");
+				return;
+			}
+			if (observed >= 0 && static_cast<std::uint64_t>(observed) != end.successes) {
+				state.SkipWithError("Unexpected result");
+				return;
+			}
+		}
+	};
+} // namespace
+
+#define ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, mix)                         \
+	BENCHMARK_CAPTURE(function, mix, mix##_mix)                               \
+	     ->ComputeStatistics("max", &compute_max)                             \
+	     ->ComputeStatistics("min", &compute_min)                             \
+	     ->ComputeStatistics("dispersion", &compute_index_of_dispersion)
+
+// a request which creates 1000 to 100000 resources, and destroys them all when it is done
+#define ZTD_OUT_PTR_SIMULATED_REQUEST_BENCHMARK(function, mix)                 \
+	BENCHMARK_CAPTURE(function, mix, mix##_mix)                               \
+	     ->RangeMultiplier(10)                                                \
+	     ->Range(1000, 100000)                                                \
+	     ->ComputeStatistics("max", &compute_max)                             \
+	     ->ComputeStatistics("min", &compute_min)                             \
+	     ->ComputeStatistics("dispersion", &compute_index_of_dispersion)
+
+#define ZTD_OUT_PTR_SIMULATED_ARENA_BENCHMARK(function)                         \
+	ZTD_OUT_PTR_SIMULATED_REQUEST_BENCHMARK(function, ideal);                  \
+	ZTD_OUT_PTR_SIMULATED_REQUEST_BENCHMARK(function, slow_destroy)
+
+#define ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(function)                           \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, ideal);                          \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, flaky_null);                     \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, flaky_unchanged);                \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, large);                          \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, slow_destroy)
+
+#define ZTD_OUT_PTR_SIMULATED_INOUT_BENCHMARK(function)                         \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, in_place);                       \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, moving);                         \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, flaky_null_resize);              \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, flaky_unchanged_resize);         \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, large_resize)
+
+#define ZTD_OUT_PTR_SIMULATED_CHURN_BENCHMARK(function)                         \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, churn);                          \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, large_churn);                    \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, slow_destroy_churn);             \
+	ZTD_OUT_PTR_SIMULATED_BENCHMARK(function, moving_churn)
+
+static void c_code_simulated_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	sim_resource* p	   = NULL;
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		// the output may be left alone on failure: it must not be left dangling
+		sim_destroy(p);
+		p = NULL;
+		sim_create(&p);
+		if (p != NULL) {
+			x += sim_get_data(p);
+			++observed;
+		}
+	}
+	counters.report(state);
+	sim_destroy(p);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(c_code_simulated_out_ptr);
+
+static void manual_simulated_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resource* temp_p = NULL;
+		sim_create(&temp_p);
+		p.reset(temp_p);
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(manual_simulated_out_ptr);
+
+static void simple_simulated_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_create(ztd::out_ptr::op_detail::simple_out_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(simple_simulated_out_ptr);
+
+static void out_ptr_simulated_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_create(ztd::out_ptr::out_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(out_ptr_simulated_out_ptr);
+
+static void policy_simulated_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		// true of every mix: sim_create either writes a null, or does not write at all
+		sim_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(policy_simulated_out_ptr);
+
+static void invoke_simulated_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		// a failed call keeps the old resource, so only a fresh one is observed
+		if (ztd::out_ptr::invoke(sim_create, [](int err) { return err == 0; }, ztd::out_ptr::out_ptr(p)) == 0 && p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(invoke_simulated_out_ptr);
+
+static void manual_simulated_shared_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::shared_ptr<sim_resource> p(nullptr);
+	simulation sim(mix);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resource* temp_p = NULL;
+		sim_create(&temp_p);
+		p.reset(temp_p, sim_deleter());
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(manual_simulated_shared_out_ptr);
+
+static void checked_simulated_shared_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::shared_ptr<sim_resource> p(nullptr);
+	simulation sim(mix);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resource* temp_p = NULL;
+		if (sim_create(&temp_p) == 0) {
+			p.reset(temp_p, sim_deleter());
+		}
+		else {
+			p.reset();
+		}
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(checked_simulated_shared_out_ptr);
+
+static void out_ptr_simulated_shared_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::shared_ptr<sim_resource> p(nullptr);
+	simulation sim(mix);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_create(ztd::out_ptr::out_ptr(p, sim_deleter()));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(out_ptr_simulated_shared_out_ptr);
+
+static void atomic_count_simulated_shared_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	atomic_count_sim_handle p;
+	simulation sim(mix);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_create(ztd::out_ptr::out_ptr(p));
+		if (p) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(atomic_count_simulated_shared_out_ptr);
+
+static void local_count_simulated_shared_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	local_count_sim_handle p;
+	simulation sim(mix);
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_create(ztd::out_ptr::out_ptr(p));
+		if (p) {
+			x += sim_get_data(p.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(local_count_simulated_shared_out_ptr);
+
+static void c_code_simulated_pair_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	sim_resource* first   = NULL;
+	sim_resource* second  = NULL;
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_destroy(first);
+		sim_destroy(second);
+		first  = NULL;
+		second = NULL;
+		sim_create_pair(&first, &second);
+		if (first != NULL && second != NULL) {
+			x += sim_get_data(first) + sim_get_data(second);
+			++observed;
+		}
+	}
+	counters.report(state);
+	sim_destroy(first);
+	sim_destroy(second);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(c_code_simulated_pair_out_ptr);
+
+static void manual_simulated_pair_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> first(nullptr);
+	std::unique_ptr<sim_resource, sim_deleter> second(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resource* temp_first  = NULL;
+		sim_resource* temp_second = NULL;
+		sim_create_pair(&temp_first, &temp_second);
+		first.reset(temp_first);
+		second.reset(temp_second);
+		if (first != nullptr && second != nullptr) {
+			x += sim_get_data(first.get()) + sim_get_data(second.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	first.reset();
+	second.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(manual_simulated_pair_out_ptr);
+
+static void out_ptr_simulated_pair_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> first(nullptr);
+	std::unique_ptr<sim_resource, sim_deleter> second(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_create_pair(ztd::out_ptr::out_ptr(first), ztd::out_ptr::out_ptr(second));
+		if (first != nullptr && second != nullptr) {
+			x += sim_get_data(first.get()) + sim_get_data(second.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	first.reset();
+	second.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(out_ptr_simulated_pair_out_ptr);
+
+static void out_ptrs_simulated_pair_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> first(nullptr);
+	std::unique_ptr<sim_resource, sim_deleter> second(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		{
+			auto outs = ztd::out_ptr::out_ptrs(first, second);
+			sim_create_pair(outs.get<0>(), outs.get<1>());
+		}
+		if (first != nullptr && second != nullptr) {
+			x += sim_get_data(first.get()) + sim_get_data(second.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	first.reset();
+	second.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(out_ptrs_simulated_pair_out_ptr);
+
+static void all_or_nothing_simulated_pair_out_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::unique_ptr<sim_resource, sim_deleter> first(nullptr);
+	std::unique_ptr<sim_resource, sim_deleter> second(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		// a failed call keeps the previous pair, so it is released first to see the same results
+		first.reset();
+		second.reset();
+		{
+			auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::all_or_nothing, first, second);
+			sim_create_pair(outs.get<0>(), outs.get<1>());
+		}
+		if (first != nullptr && second != nullptr) {
+			x += sim_get_data(first.get()) + sim_get_data(second.get());
+			++observed;
+		}
+	}
+	counters.report(state);
+	first.reset();
+	second.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_OUT_BENCHMARK(all_or_nothing_simulated_pair_out_ptr);
+
+static void c_code_simulated_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	sim_resource* p = NULL;
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resize(&p);
+		if (p != NULL) {
+			x += sim_get_data(p);
+		}
+	}
+	counters.report(state);
+	sim_destroy(p);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_INOUT_BENCHMARK(c_code_simulated_inout_ptr);
+
+static void manual_simulated_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resource* temp_p = p.release();
+		sim_resize(&temp_p);
+		p.reset(temp_p);
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_INOUT_BENCHMARK(manual_simulated_inout_ptr);
+
+static void simple_simulated_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resize(ztd::out_ptr::op_detail::simple_inout_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_INOUT_BENCHMARK(simple_simulated_inout_ptr);
+
+static void clever_simulated_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resize(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	p.reset();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_INOUT_BENCHMARK(clever_simulated_inout_ptr);
+
+static void c_code_simulated_churn_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		sim_resource* p = NULL;
+		sim_resize(&p);
+		if (p != NULL) {
+			x += sim_get_data(p);
+		}
+		sim_destroy(p);
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_CHURN_BENCHMARK(c_code_simulated_churn_inout_ptr);
+
+static void simple_simulated_churn_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+		sim_resize(ztd::out_ptr::op_detail::simple_inout_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_CHURN_BENCHMARK(simple_simulated_churn_inout_ptr);
+
+static void clever_simulated_churn_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::unique_ptr<sim_resource, sim_deleter> p(nullptr);
+		sim_resize(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_CHURN_BENCHMARK(clever_simulated_churn_inout_ptr);
+
+static void handle_pool_simulated_churn_inout_ptr(benchmark::State& state, const sim_config& mix) {
+	std::int64_t x = 0;
+	sim_pool::drain();
+	simulation sim(mix);
+	pool_tally<sim_pool> pool;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		// sim_resize re-creates into the resource the previous iteration gave back
+		pooled_sim_handle p(nullptr);
+		sim_resize(ztd::out_ptr::inout_ptr(p));
+		if (p != nullptr) {
+			x += sim_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	pool.report(state);
+	sim_pool::drain();
+	benchmark::DoNotOptimize(x);
+	sim.report(state, -1);
+}
+ZTD_OUT_PTR_SIMULATED_CHURN_BENCHMARK(handle_pool_simulated_churn_inout_ptr);
+
+static void c_code_simulated_request_out_ptr(benchmark::State& state, const sim_config& mix) {
+	const std::size_t n	   = static_cast<std::size_t>(state.range(0));
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::vector<sim_resource*> resources(n, NULL);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		for (std::size_t i = 0; i < n; ++i) {
+			resources[i] = NULL;
+			sim_create(&resources[i]);
+			if (resources[i] != NULL) {
+				x += sim_get_data(resources[i]);
+				++observed;
+			}
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			sim_destroy(resources[i]);
+		}
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_ARENA_BENCHMARK(c_code_simulated_request_out_ptr);
+
+static void simple_simulated_request_out_ptr(benchmark::State& state, const sim_config& mix) {
+	const std::size_t n	   = static_cast<std::size_t>(state.range(0));
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::vector<std::unique_ptr<sim_resource, sim_deleter>> handles;
+	handles.reserve(n);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		for (std::size_t i = 0; i < n; ++i) {
+			handles.emplace_back(nullptr);
+			sim_create(ztd::out_ptr::op_detail::simple_out_ptr(handles.back()));
+			if (handles.back() != nullptr) {
+				x += sim_get_data(handles.back().get());
+				++observed;
+			}
+		}
+		// one deleter call per handle
+		handles.clear();
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_ARENA_BENCHMARK(simple_simulated_request_out_ptr);
+
+static void clever_simulated_request_out_ptr(benchmark::State& state, const sim_config& mix) {
+	const std::size_t n	   = static_cast<std::size_t>(state.range(0));
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::vector<std::unique_ptr<sim_resource, sim_deleter>> handles;
+	handles.reserve(n);
+	simulation sim(mix);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		for (std::size_t i = 0; i < n; ++i) {
+			handles.emplace_back(nullptr);
+			sim_create(ztd::out_ptr::op_detail::clever_out_ptr(handles.back()));
+			if (handles.back() != nullptr) {
+				x += sim_get_data(handles.back().get());
+				++observed;
+			}
+		}
+		handles.clear();
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_ARENA_BENCHMARK(clever_simulated_request_out_ptr);
+
+static void arena_simulated_request_out_ptr(benchmark::State& state, const sim_config& mix) {
+	const std::size_t n	   = static_cast<std::size_t>(state.range(0));
+	std::int64_t x		   = 0;
+	std::int64_t observed = 0;
+	std::vector<sim_arena_handle> handles;
+	handles.reserve(n);
+	simulation sim(mix);
+	sim_arena arena;
+	// the records are kept across requests, so committing never allocates after the first
+	arena.reserve(n);
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		for (std::size_t i = 0; i < n; ++i) {
+			handles.emplace_back(arena);
+			sim_create(ztd::out_ptr::out_ptr(handles.back()));
+			if (handles.back()) {
+				x += sim_get_data(handles.back().get());
+				++observed;
+			}
+		}
+		handles.clear();
+		// one sim_destroy_many call for the whole request
+		arena.release();
+	}
+	counters.report(state);
+	benchmark::DoNotOptimize(x);
+	sim.report(state, observed);
+}
+ZTD_OUT_PTR_SIMULATED_ARENA_BENCHMARK(arena_simulated_request_out_ptr);
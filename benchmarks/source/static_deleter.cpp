@@ -0,0 +1,362 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/perf_counters.hpp>
+
+#include <benchmark/benchmark.h>
+
+// the "static" variants measure the opt-in static deleter path
+#define ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR 1
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/static_deleter.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <cstddef>
+
+// The same handle, with the deleter stored as a function pointer (16 bytes, indirect call)
+// or fixed at compile time (8 bytes, direct call), run through each existing category
+using fnptr_handle  = std::unique_ptr<ficapi::opaque, void (*)(ficapi_opaque_handle)>;
+using static_handle = ztd::out_ptr::basic_c_handle<ficapi::opaque, decltype(&ficapi_handle_no_alloc_delete), &ficapi_handle_no_alloc_delete>;
+using static_deleter_t = static_handle::deleter_type;
+
+static void fnptr_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		fnptr_handle p(nullptr, &ficapi_handle_no_alloc_delete);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		static_handle p(nullptr);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void fnptr_reset_out_ptr(benchmark::State& state) {
+	fnptr_handle p(nullptr, &ficapi_handle_no_alloc_delete);
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_reset_out_ptr(benchmark::State& state) {
+	static_handle p(nullptr);
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void fnptr_local_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		fnptr_handle p(nullptr, &ficapi_handle_no_alloc_delete);
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_local_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_local_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		static_handle p(nullptr);
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_local_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void fnptr_reset_inout_ptr(benchmark::State& state) {
+	fnptr_handle p(nullptr, &ficapi_handle_no_alloc_delete);
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_reset_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_reset_inout_ptr(benchmark::State& state) {
+	static_handle p(nullptr);
+	int64_t x = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_reset_inout_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void fnptr_shared_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::shared_ptr<ficapi::opaque> p(nullptr);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, &ficapi_handle_no_alloc_delete));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_shared_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_shared_local_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::shared_ptr<ficapi::opaque> p(nullptr);
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, static_deleter_t()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_shared_local_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void fnptr_shared_reset_out_ptr(benchmark::State& state) {
+	std::shared_ptr<ficapi::opaque> p(nullptr);
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, &ficapi_handle_no_alloc_delete));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_shared_reset_out_ptr(benchmark::State& state) {
+	std::shared_ptr<ficapi::opaque> p(nullptr);
+	int64_t x = 0;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, static_deleter_t()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	allocations.report(state);
+	int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_shared_reset_out_ptr)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+// a function pointer deleter cannot be default-constructed, which rules out batch_out_ptr's
+// resize: both variants fill every element with its own out_ptr, as out_ptr_batch_out_ptr does
+static void fnptr_batch_out_ptr(benchmark::State& state) {
+	const std::size_t n = static_cast<std::size_t>(state.range(0));
+	int64_t x		    = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::vector<fnptr_handle> handles;
+		handles.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			handles.emplace_back(nullptr, &ficapi_handle_no_alloc_delete);
+		}
+		for (auto& p : handles) {
+			ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		}
+		for (const auto& p : handles) {
+			x += ficapi_handle_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * int64_t(n) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(fnptr_batch_out_ptr)
+	->RangeMultiplier(8)
+	->Range(1, 65536)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void static_batch_out_ptr(benchmark::State& state) {
+	const std::size_t n = static_cast<std::size_t>(state.range(0));
+	int64_t x		    = 0;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		std::vector<static_handle> handles(n);
+		for (auto& p : handles) {
+			ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		}
+		for (const auto& p : handles) {
+			x += ficapi_handle_get_data(p.get());
+		}
+	}
+	counters.report(state);
+	int64_t expected = int64_t(state.iterations()) * int64_t(n) * ficapi_get_data();
+	if (x != expected) {
+		state.SkipWithError("Unexpected result");
+		return;
+	}
+}
+BENCHMARK(static_batch_out_ptr)
+	->RangeMultiplier(8)
+	->Range(1, 65536)
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
@@ -0,0 +1,870 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/statistics.hpp>
+#include <benchmarks/allocation_counter.hpp>
+#include <benchmarks/threads.hpp>
+#include <benchmarks/perf_counters.hpp>
+#include <benchmarks/shared_handles.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+#include <ztd/out_ptr/thread_pooled_allocator.hpp>
+#include <ztd/out_ptr/atomic_shared_ptr.hpp>
+#include <ztd/out_ptr/epoch_handle.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <shared_mutex>
+#endif
+
+// Every benchmark here runs on 1 to max_benchmark_threads() threads at once, each working on
+// the handle in its own slot. Time is wall-clock, and "items_per_second" is the throughput
+// of all threads together: a variant that scales keeps it growing with the thread count
+using unique_handle = std::unique_ptr<ficapi::opaque, ficapi::handle_no_alloc_deleter>;
+using shared_handle = std::shared_ptr<ficapi::opaque>;
+
+namespace {
+	padded<ficapi_opaque_handle> c_slots[benchmark_thread_slots];
+	padded<unique_handle> unique_slots[benchmark_thread_slots];
+	padded<shared_handle> shared_slots[benchmark_thread_slots];
+	padded<atomic_count_handle> atomic_count_slots[benchmark_thread_slots];
+	padded<local_count_handle> local_count_slots[benchmark_thread_slots];
+	// 8 handles to a cache line: every commit into one thread's handle
+	// takes the line away from up to 7 other threads
+	unique_handle packed_unique_slots[benchmark_thread_slots];
+
+	// a reference every thread takes and drops again, so its count is contended
+	const shared_handle& shared_owner() {
+		static const shared_handle owner = []() {
+			ficapi_opaque_handle p = NULL;
+			ficapi_handle_no_alloc_create(&p);
+			return shared_handle(p, ficapi::handle_no_alloc_deleter());
+		}();
+		return owner;
+	}
+
+	const atomic_count_handle& atomic_count_owner() {
+		static const atomic_count_handle owner = []() {
+			ficapi_opaque_handle p = NULL;
+			ficapi_handle_no_alloc_create(&p);
+			return atomic_count_handle(p);
+		}();
+		return owner;
+	}
+
+	shared_handle make_shared_handle() {
+		ficapi_opaque_handle p = NULL;
+		ficapi_handle_no_alloc_create(&p);
+		return shared_handle(p, ficapi::handle_no_alloc_deleter());
+	}
+
+	// the "publish" benchmarks: thread 0 publishes a new handle every iteration, and every
+	// other thread reads whichever handle is published. Each starts out with one, so a
+	// reader never finds it empty
+	struct mutex_publication {
+		std::mutex lock;
+		shared_handle value = make_shared_handle();
+	};
+	mutex_publication mutex_published;
+	ztd::out_ptr::epoch_handle<ficapi::opaque, ficapi::handle_no_alloc_deleter> epoch_published([]() {
+		ficapi_opaque_handle p = NULL;
+		ficapi_handle_no_alloc_create(&p);
+		return p;
+	}());
+#if ZTD_OUT_PTR_HAS_ATOMIC_SHARED_PTR_I_
+	std::atomic<shared_handle> atomic_published(make_shared_handle());
+#endif
+
+	// the "read mostly" benchmarks: thread 0 re-creates the handle every iteration through
+	// inout_ptr, and every other thread looks it up. These handles are really allocated and
+	// freed, so a reader that is not protected from the writer would be reading freed memory
+	using dynamic_handle = std::unique_ptr<ficapi::opaque, ficapi::handle_deleter>;
+
+	ficapi_opaque_handle make_dynamic_handle() {
+		ficapi_opaque_handle p = NULL;
+		ficapi_handle_create(&p);
+		return p;
+	}
+
+	// handles from ficapi_handle_create carry the dynamic data: each lookup which finds it
+	// counts as the usual data, so report_throughput checks these like every other benchmark
+	int64_t look_up(ficapi_opaque_handle p) {
+		return ficapi_handle_get_data(p) == ficapi_get_dynamic_data() ? ficapi_get_data() : 0;
+	}
+
+	// ficapi_handle_re_create frees the handle it is given, which the epoch variant cannot
+	// allow: its readers may still be using it. This creates the replacement and leaves the
+	// old handle alone, the way a copy-on-write C API would
+	void ficapi_handle_derive(ficapi_opaque_handle* inout) {
+		ficapi_handle_create(inout);
+	}
+
+	struct mutex_read_mostly_handle {
+		std::mutex lock;
+		dynamic_handle value { make_dynamic_handle() };
+	};
+	mutex_read_mostly_handle mutex_read_mostly;
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	struct shared_mutex_read_mostly_handle {
+		std::shared_mutex lock;
+		dynamic_handle value { make_dynamic_handle() };
+	};
+	shared_mutex_read_mostly_handle shared_mutex_read_mostly;
+#endif
+	ztd::out_ptr::epoch_handle<ficapi::opaque, ficapi::handle_deleter> epoch_read_mostly(make_dynamic_handle());
+
+	// for the benchmarks where thread 0 writes and every other thread reads: "writes" and
+	// "reads" per second, and "read_ns", the time each read took on average (measured by
+	// every reader over its own loop, since the iteration time covers both sides)
+	class role_tally {
+	private:
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		role_tally() : m_start(std::chrono::steady_clock::now()) {
+		}
+
+		void report(benchmark::State& state) const {
+			const bool writer		  = state.thread_index() == 0;
+			const double iterations = static_cast<double>(state.iterations());
+			const double readers	  = static_cast<double>(state.threads() - 1);
+			const double elapsed_ns
+				= static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+			state.counters["writes"]	= benchmark::Counter(writer ? iterations : 0.0, benchmark::Counter::kIsRate);
+			state.counters["reads"]	= benchmark::Counter(writer ? 0.0 : iterations, benchmark::Counter::kIsRate);
+			// summed over the threads, so each reader adds its share of the average
+			state.counters["read_ns"] = benchmark::Counter(writer || iterations == 0.0 ? 0.0 : elapsed_ns / iterations / readers);
+		}
+	};
+
+	void report_throughput(benchmark::State& state, int64_t x) {
+		state.SetItemsProcessed(state.iterations());
+		int64_t expected = int64_t(state.iterations()) * ficapi_get_data();
+		if (x != expected) {
+			state.SkipWithError("Unexpected result");
+		}
+	}
+} // namespace
+
+static void c_code_threaded_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	ficapi_opaque_handle& p = c_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (p != NULL) {
+			ficapi_handle_no_alloc_delete(p);
+		}
+		ficapi_handle_no_alloc_create(&p);
+		x += ficapi_handle_get_data(p);
+	}
+	counters.report(state);
+	if (p != NULL) {
+		ficapi_handle_no_alloc_delete(p);
+		p = NULL;
+	}
+	report_throughput(state, x);
+}
+BENCHMARK(c_code_threaded_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_threaded_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create(&temp_p);
+		p.reset(temp_p);
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(manual_threaded_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void simple_threaded_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::simple_out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(simple_threaded_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void clever_threaded_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(clever_threaded_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void c_code_threaded_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	ficapi_opaque_handle& p = c_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(&p);
+		x += ficapi_handle_get_data(p);
+	}
+	counters.report(state);
+	if (p != NULL) {
+		ficapi_handle_no_alloc_delete(p);
+		p = NULL;
+	}
+	report_throughput(state, x);
+}
+BENCHMARK(c_code_threaded_reset_inout_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void manual_threaded_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = p.release();
+		ficapi_handle_no_alloc_re_create(&temp_p);
+		p.reset(temp_p);
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(manual_threaded_reset_inout_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void simple_threaded_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::simple_inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(simple_threaded_reset_inout_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void clever_threaded_reset_inout_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(clever_threaded_reset_inout_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+// every commit allocates a control block (but for "recycling"), so these measure the allocator as much as anything
+static void manual_threaded_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	shared_handle& p = shared_slots[state.thread_index()].value;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create(&temp_p);
+		p.reset(temp_p, ficapi::handle_no_alloc_deleter());
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(manual_threaded_shared_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void out_ptr_threaded_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	shared_handle& p = shared_slots[state.thread_index()].value;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(out_ptr_threaded_shared_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void pooled_threaded_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	shared_handle& p = shared_slots[state.thread_index()].value;
+	ztd::out_ptr::thread_pooled_allocator<ficapi::opaque> alloc;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, ficapi::handle_no_alloc_deleter(), alloc));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(pooled_threaded_shared_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void recycling_threaded_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	shared_handle& p = shared_slots[state.thread_index()].value;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::recycling_out_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(recycling_threaded_shared_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_count_threaded_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	atomic_count_handle& p = atomic_count_slots[state.thread_index()].value;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(atomic_count_threaded_shared_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void local_count_threaded_shared_reset_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	local_count_handle& p = local_count_slots[state.thread_index()].value;
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(local_count_threaded_shared_reset_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+// each thread's handle starts every iteration as one more owner of the same object,
+// so the commit also drops a reference whose count every other thread is hammering on
+static void manual_threaded_shared_owner_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	shared_handle& p = shared_slots[state.thread_index()].value;
+	const shared_handle& owner = shared_owner();
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		p = owner;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create(&temp_p);
+		p.reset(temp_p, ficapi::handle_no_alloc_deleter());
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(manual_threaded_shared_owner_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void out_ptr_threaded_shared_owner_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	shared_handle& p = shared_slots[state.thread_index()].value;
+	const shared_handle& owner = shared_owner();
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		p = owner;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p, ficapi::handle_no_alloc_deleter()));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(out_ptr_threaded_shared_owner_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_count_threaded_shared_owner_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	atomic_count_handle& p = atomic_count_slots[state.thread_index()].value;
+	const atomic_count_handle& owner = atomic_count_owner();
+	allocation_tally allocations;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		p = owner;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	allocations.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(atomic_count_threaded_shared_owner_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+// the same work as the "threaded reset" benchmarks, with each thread's handle either
+// sharing a cache line with its neighbours' ("packed") or alone on one ("padded")
+static void packed_manual_threaded_false_sharing_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = packed_unique_slots[state.thread_index()];
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create(&temp_p);
+		p.reset(temp_p);
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(packed_manual_threaded_false_sharing_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void packed_clever_threaded_false_sharing_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = packed_unique_slots[state.thread_index()];
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(packed_clever_threaded_false_sharing_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void padded_manual_threaded_false_sharing_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_opaque_handle temp_p = NULL;
+		ficapi_handle_no_alloc_create(&temp_p);
+		p.reset(temp_p);
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(padded_manual_threaded_false_sharing_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void padded_clever_threaded_false_sharing_out_ptr(benchmark::State& state) {
+	int64_t x = 0;
+	unique_handle& p = unique_slots[state.thread_index()].value;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ficapi_handle_no_alloc_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+		x += ficapi_handle_get_data(p.get());
+	}
+	counters.report(state);
+	p.reset();
+	report_throughput(state, x);
+}
+BENCHMARK(padded_clever_threaded_false_sharing_out_ptr)
+	->ThreadRange(1, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void mutex_threaded_publish_out_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (writer) {
+			shared_handle fresh;
+			ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(fresh, ficapi::handle_no_alloc_deleter()));
+			x += ficapi_handle_get_data(fresh.get());
+			{
+				std::lock_guard<std::mutex> guard(mutex_published.lock);
+				mutex_published.value.swap(fresh);
+			}
+			// the replaced handle is let go of outside the lock
+		}
+		else {
+			shared_handle seen;
+			{
+				std::lock_guard<std::mutex> guard(mutex_published.lock);
+				seen = mutex_published.value;
+			}
+			x += ficapi_handle_get_data(seen.get());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(mutex_threaded_publish_out_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+#if ZTD_OUT_PTR_HAS_ATOMIC_SHARED_PTR_I_
+
+static void store_threaded_publish_out_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (writer) {
+			shared_handle fresh;
+			ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(fresh, ficapi::handle_no_alloc_deleter()));
+			x += ficapi_handle_get_data(fresh.get());
+			atomic_published.store(std::move(fresh), std::memory_order_release);
+		}
+		else {
+			shared_handle seen = atomic_published.load(std::memory_order_acquire);
+			x += ficapi_handle_get_data(seen.get());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(store_threaded_publish_out_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void atomic_threaded_publish_out_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (writer) {
+			ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(atomic_published, ficapi::handle_no_alloc_deleter()));
+			x += ficapi_get_data();
+		}
+		else {
+			shared_handle seen = atomic_published.load(std::memory_order_acquire);
+			x += ficapi_handle_get_data(seen.get());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(atomic_threaded_publish_out_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+#endif // atomic shared_ptr
+
+// readers load the raw pointer without a lock, inside an epoch_guard: a replaced handle is
+// retired, and only destroyed once no reader can still be reading it
+static void epoch_threaded_publish_out_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ztd::out_ptr::epoch_guard guard;
+		if (writer) {
+			ficapi_handle_no_alloc_create(ztd::out_ptr::out_ptr(epoch_published));
+			x += ficapi_get_data();
+		}
+		else {
+			x += ficapi_handle_get_data(epoch_published.load());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(epoch_threaded_publish_out_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+static void mutex_threaded_read_mostly_inout_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (writer) {
+			std::lock_guard<std::mutex> guard(mutex_read_mostly.lock);
+			ficapi_handle_re_create(ztd::out_ptr::inout_ptr(mutex_read_mostly.value));
+			x += look_up(mutex_read_mostly.value.get());
+		}
+		else {
+			std::lock_guard<std::mutex> guard(mutex_read_mostly.lock);
+			x += look_up(mutex_read_mostly.value.get());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(mutex_threaded_read_mostly_inout_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+
+static void shared_mutex_threaded_read_mostly_inout_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		if (writer) {
+			std::unique_lock<std::shared_mutex> guard(shared_mutex_read_mostly.lock);
+			ficapi_handle_re_create(ztd::out_ptr::inout_ptr(shared_mutex_read_mostly.value));
+			x += look_up(shared_mutex_read_mostly.value.get());
+		}
+		else {
+			std::shared_lock<std::shared_mutex> guard(shared_mutex_read_mostly.lock);
+			x += look_up(shared_mutex_read_mostly.value.get());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(shared_mutex_threaded_read_mostly_inout_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
+
+#endif // shared_mutex
+
+// readers never wait on the writer, and the writer never waits on readers: a re-created
+// handle is retired, and freed by a later re-create once no reader can still hold it
+static void epoch_threaded_read_mostly_inout_ptr(benchmark::State& state) {
+	int64_t x		= 0;
+	const bool writer = state.thread_index() == 0;
+	allocation_tally allocations;
+	role_tally roles;
+	perf_tally counters;
+	for (auto _ : state) {
+		(void)_;
+		ztd::out_ptr::epoch_guard guard;
+		if (writer) {
+			ficapi_handle_derive(ztd::out_ptr::inout_ptr(epoch_read_mostly));
+			x += look_up(epoch_read_mostly.load());
+		}
+		else {
+			x += look_up(epoch_read_mostly.load());
+		}
+	}
+	counters.report(state);
+	allocations.report(state);
+	roles.report(state);
+	report_throughput(state, x);
+}
+BENCHMARK(epoch_threaded_read_mostly_inout_ptr)
+	->ThreadRange(2, max_benchmark_threads())
+	->UseRealTime()
+	->ComputeStatistics("max", &compute_max)
+	->ComputeStatistics("min", &compute_min)
+	->ComputeStatistics("dispersion", &compute_index_of_dispersion);
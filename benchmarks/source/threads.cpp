@@ -0,0 +1,25 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <benchmarks/threads.hpp>
+
+#include <thread>
+#include <algorithm>
+
+int max_benchmark_threads() {
+	int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+	return (std::min)((std::max)(hardware_threads, 2), benchmark_thread_slots);
+}
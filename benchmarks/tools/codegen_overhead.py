@@ -0,0 +1,246 @@
+# Compiles benchmarks/codegen/kernels.cpp with every given compiler and optimization level,
+# disassembles it, and compares each adaptor kernel against the hand-written baseline of its
+# category. Exits non-zero if any adaptor goes over the overhead budget.
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+metric_names = ["instructions", "calls", "stack"]
+
+address_pattern = re.compile(r"^\s*[0-9a-f]+:\s+(.*)$")
+symbol_pattern = re.compile(r"^[0-9a-f]+ <([^>]+)>:$")
+relocation_pattern = re.compile(r"^R_\S+\s+([^\s+-]+)")
+x86_stack_pattern = re.compile(r"\(%[re]sp[,)]")
+arm_stack_pattern = re.compile(r"\[sp[,\]]")
+
+call_mnemonics = ["call", "callq", "bl", "blr", "jal", "jalr"]
+jump_mnemonics = ["jmp", "jmpq", "b", "br", "j", "jr"]
+push_pop_mnemonics = ["push", "pushq", "pop", "popq"]
+prefixes = ["lock", "rep", "repz", "repnz", "notrack", "bnd", "cs", "ds", "data16"]
+
+
+def is_padding(mnemonic, operands):
+	if mnemonic.startswith("nop") or mnemonic in ["int3", "ud2", "hlt"]:
+		return True
+	# the 2-byte nop, as GNU objdump prints it
+	return mnemonic == "xchg" and operands == "%ax,%ax"
+
+
+def split_instruction(text):
+	# objdump -w puts the relocation for an instruction on the same line, after a tab:
+	# "call   18 <f+0x18>\t14: R_X86_64_PLT32\tficapi_handle_get_data-0x4"
+	parts = text.split("\t")
+	for index, part in enumerate(parts):
+		if re.match(r"^\s*[0-9a-f]+: R_", part):
+			m = relocation_pattern.match(" ".join(parts[index:]).split(":", 1)[1].strip())
+			return " ".join(parts[:index]).strip(), m.group(1) if m else None
+	return " ".join(parts).strip(), None
+
+
+def disassemble(objdump, object_file):
+	output = subprocess.run([objdump, "-d", "-r", "-w", "--no-show-raw-insn", object_file],
+	                        check=True,
+	                        stdout=subprocess.PIPE,
+	                        universal_newlines=True).stdout
+	functions = {}
+	current = None
+	for line in output.splitlines():
+		m = symbol_pattern.match(line)
+		if m:
+			current = []
+			functions[m.group(1)] = current
+			continue
+		if current is None:
+			continue
+		m = address_pattern.match(line)
+		if not m:
+			continue
+		text = m.group(1)
+		if text.startswith("R_"):
+			# relocation on its own line: attach it to the previous instruction
+			r = relocation_pattern.match(text)
+			if r and current:
+				current[-1]["relocation"] = r.group(1)
+			continue
+		instruction, relocation = split_instruction(text)
+		pieces = instruction.split(None, 1)
+		if not pieces:
+			continue
+		mnemonic = pieces[0]
+		operands = pieces[1] if len(pieces) > 1 else ""
+		# prefixes are part of the instruction, not the mnemonic: "data16 cs nopw 0x0(%rax,%rax,1)"
+		while mnemonic in prefixes and operands:
+			pieces = operands.split(None, 1)
+			mnemonic = pieces[0]
+			operands = pieces[1] if len(pieces) > 1 else ""
+		if mnemonic in prefixes:
+			# llvm-objdump prints a prefix on its own line, before the instruction it applies to
+			continue
+		current.append({
+		    "mnemonic": mnemonic,
+		    "operands": operands,
+		    "relocation": relocation
+		})
+	return functions
+
+
+def measure(name, instructions):
+	counts = {"instructions": 0, "calls": 0, "stack": 0}
+	for i in instructions:
+		mnemonic = i["mnemonic"]
+		operands = i["operands"]
+		if is_padding(mnemonic, operands):
+			continue
+		counts["instructions"] += 1
+		relocation = i["relocation"]
+		if mnemonic in call_mnemonics:
+			counts["calls"] += 1
+		elif mnemonic in jump_mnemonics and relocation is not None and not relocation.startswith(
+		    ".") and relocation != name:
+			# a tail call to another function
+			counts["calls"] += 1
+		if mnemonic in push_pop_mnemonics or mnemonic in ["stp", "ldp"] and "sp" in operands:
+			counts["stack"] += 1
+		elif not mnemonic.startswith("lea") and (x86_stack_pattern.search(operands)
+		                                         or arm_stack_pattern.search(operands)):
+			counts["stack"] += 1
+	return counts
+
+
+def compile_kernels(compiler, optimization, args, object_file):
+	command = [compiler, "-std=" + args.std, "-" + optimization, "-DNDEBUG", "-c", args.source, "-o", object_file]
+	# the lists come straight from CMake target properties, which may hold empty entries
+	command += ["-I" + d for d in args.include_dirs if d]
+	command += ["-D" + d for d in args.definitions if d]
+	subprocess.run(command, check=True)
+
+
+def find_compilers(compilers):
+	# the same compiler can show up under several names (c++, g++, g++-12)
+	found = []
+	seen = set()
+	for c in compilers:
+		path = shutil.which(c) if c else None
+		if path is None:
+			continue
+		path = os.path.realpath(path)
+		if path in seen:
+			continue
+		seen.add(path)
+		found.append(c)
+	return found
+
+
+def budget_for(budget, variant, name):
+	# most specific wins: the kernel's own entry, then its variant's, then the default
+	limits = dict(budget.get("default", {}))
+	limits.update(budget.get("variants", {}).get(variant, {}))
+	limits.update(budget.get("overrides", {}).get(name, {}))
+	return limits
+
+
+def check(budget, compiler, optimization, functions, report):
+	failures = []
+	label = "{} -{}".format(os.path.basename(compiler), optimization)
+	print("")
+	print(label)
+	print("  {:<40} {:>13} {:>9} {:>9}".format("kernel", "instructions", "calls", "stack"))
+	for category, description in budget["categories"].items():
+		baseline_name = description["baseline"] + "_" + category
+		if baseline_name not in functions:
+			print("  {:<40} (missing)".format(baseline_name))
+			continue
+		baseline = measure(baseline_name, functions[baseline_name])
+		names = [n for n in functions if n.endswith("_" + category) and n != baseline_name]
+		# a longer category sharing this suffix claims its own kernels
+		names = [
+		    n for n in names if not any(
+		        other != category and n.endswith("_" + other) and len(other) > len(category)
+		        for other in budget["categories"])
+		]
+		print("  {:<40} {:>13} {:>9} {:>9}".format(baseline_name, baseline["instructions"], baseline["calls"],
+		                                           baseline["stack"]))
+		for name in sorted(names):
+			counts = measure(name, functions[name])
+			variant = name[:-len("_" + category)]
+			checked = variant in description.get("checked", [])
+			limits = budget_for(budget, variant, name)
+			cells = []
+			over = []
+			for metric in metric_names:
+				delta = counts[metric] - baseline[metric]
+				cells.append("{} ({:+d})".format(counts[metric], delta))
+				if checked and metric in limits and delta > limits[metric]:
+					over.append("{} {:+d} > {:+d}".format(metric, delta, limits[metric]))
+			status = ""
+			if over:
+				status = "  OVER BUDGET: " + ", ".join(over)
+				failures.append("{}: {}: {}".format(label, name, ", ".join(over)))
+			elif not checked:
+				status = "  (not checked)"
+			print("  {:<40} {:>13} {:>9} {:>9}{}".format(name, *cells, status))
+			report.append({
+			    "compiler": compiler,
+			    "optimization": optimization,
+			    "category": category,
+			    "variant": variant,
+			    "baseline": baseline,
+			    "counts": counts,
+			    "checked": checked,
+			    "over_budget": over
+			})
+	return failures
+
+
+def main():
+	parser = argparse.ArgumentParser(
+	    "codegen_overhead.py",
+	    description="Count the instructions, calls and stack traffic each out_ptr adaptor adds over hand-written C")
+	parser.add_argument("-s", "--source", required=True)
+	parser.add_argument("-b", "--budget", required=True, type=argparse.FileType("r"))
+	parser.add_argument("-c", "--compilers", nargs="+", required=True)
+	parser.add_argument("-O", "--optimizations", nargs="+", default=["O2", "O3"])
+	parser.add_argument("-I", "--include_dirs", nargs="*", default=[])
+	parser.add_argument("-D", "--definitions", nargs="*", default=[])
+	parser.add_argument("--std", default="c++11")
+	parser.add_argument("--objdump", default="objdump")
+	parser.add_argument("-w", "--work_dir", default=".")
+	parser.add_argument("-o", "--output", nargs="?")
+	args = parser.parse_args()
+
+	budget = json.load(args.budget)
+	os.makedirs(args.work_dir, exist_ok=True)
+	failures = []
+	report = []
+	compilers = find_compilers(args.compilers)
+	if not compilers:
+		print("none of the compilers {} could be found".format(", ".join(args.compilers)))
+		return 1
+	for compiler in compilers:
+		for optimization in args.optimizations:
+			object_file = os.path.join(args.work_dir, "kernels.{}.{}.o".format(
+			    os.path.basename(compiler), optimization))
+			compile_kernels(compiler, optimization, args, object_file)
+			functions = disassemble(args.objdump, object_file)
+			failures += check(budget, compiler, optimization, functions, report)
+
+	if args.output:
+		with open(args.output, "w") as f:
+			json.dump(report, f, indent="\t")
+
+	print("")
+	if failures:
+		print("{} kernel(s) over the codegen overhead budget:".format(len(failures)))
+		for f in failures:
+			print("  " + f)
+		return 1
+	print("all checked kernels are within the codegen overhead budget")
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,210 @@
+# Compares two Google-Benchmark JSON result files (a baseline and a candidate) benchmark by
+# benchmark. The repetitions of each are compared with a Mann-Whitney U test, and the shift
+# between them is estimated with a confidence interval (Hodges-Lehmann), so that run-to-run
+# noise is not reported as a change. Exits non-zero when any benchmark got significantly slower.
+import argparse
+import json
+import math
+import sys
+
+time_units_to_ns = {
+    "ns": 1.0,
+    "us": 1e3,
+    "µs": 1e3,
+    "ms": 1e6,
+    "s": 1e9,
+}
+
+
+def load_repetitions(f, data_point_name):
+	# one value per repetition, for each benchmark run
+	j = json.load(f)
+	runs = {}
+	for j_benchmark in j["benchmarks"]:
+		name = j_benchmark['name']
+		run_name = j_benchmark['run_name']
+		if name != run_name or j_benchmark.get('run_type', 'iteration') != 'iteration':
+			# aggregates are recomputed from the repetitions themselves
+			continue
+		if j_benchmark.get('error_occurred'):
+			runs.setdefault(run_name, [])
+			continue
+		point = j_benchmark.get(data_point_name)
+		if point == None:
+			continue
+		if data_point_name in ["real_time", "cpu_time"]:
+			point *= time_units_to_ns[j_benchmark['time_unit']]
+		runs.setdefault(run_name, []).append(float(point))
+	return runs
+
+
+def normal_cdf(z):
+	return 0.5 * math.erfc(-z / math.sqrt(2.0))
+
+
+def normal_quantile(p):
+	# inverse of normal_cdf by bisection: plenty precise for picking an order statistic
+	low, high = -10.0, 10.0
+	for _ in range(100):
+		middle = (low + high) / 2
+		if normal_cdf(middle) < p:
+			low = middle
+		else:
+			high = middle
+	return (low + high) / 2
+
+
+def mann_whitney_u(baseline, candidate):
+	# two-sided p-value, from the normal approximation with tie and continuity corrections;
+	# sound for the tens to hundreds of repetitions the benchmarks are run with
+	n, m = len(baseline), len(candidate)
+	combined = sorted([(x, 0) for x in baseline] + [(x, 1) for x in candidate])
+	ranks = [0.0] * len(combined)
+	tie_sum = 0.0
+	i = 0
+	while i < len(combined):
+		k = i
+		while k + 1 < len(combined) and combined[k + 1][0] == combined[i][0]:
+			k += 1
+		rank = (i + k) / 2.0 + 1.0
+		for r in range(i, k + 1):
+			ranks[r] = rank
+		t = k - i + 1
+		tie_sum += t * t * t - t
+		i = k + 1
+	candidate_rank_sum = sum(r for r, (_, which) in zip(ranks, combined) if which == 1)
+	u = candidate_rank_sum - m * (m + 1) / 2.0
+	mean = n * m / 2.0
+	total = n + m
+	variance = n * m / 12.0 * ((total + 1) - tie_sum / (total * (total - 1)))
+	if variance <= 0:
+		return u, 1.0
+	z = (abs(u - mean) - 0.5) / math.sqrt(variance)
+	return u, min(1.0, 2.0 * (1.0 - normal_cdf(max(z, 0.0))))
+
+
+def hodges_lehmann(baseline, candidate, confidence):
+	# the median of all pairwise differences (candidate - baseline) estimates the shift;
+	# order statistics of those differences give a distribution-free confidence interval
+	n, m = len(baseline), len(candidate)
+	differences = sorted(c - b for b in baseline for c in candidate)
+	count = len(differences)
+	middle = count // 2
+	shift = differences[middle] if count % 2 == 1 else (differences[middle - 1] + differences[middle]) / 2.0
+	z = normal_quantile(1.0 - (1.0 - confidence) / 2.0)
+	k = int(math.floor(n * m / 2.0 - z * math.sqrt(n * m * (n + m + 1) / 12.0)))
+	k = max(0, min(k, middle))
+	return shift, differences[k], differences[count - 1 - k]
+
+
+def median(values):
+	values = sorted(values)
+	middle = len(values) // 2
+	return values[middle] if len(values) % 2 == 1 else (values[middle - 1] + values[middle]) / 2.0
+
+
+def holm(p_values):
+	# Holm-Bonferroni: adjusted p-values which keep the chance of any false
+	# "significant" across all the benchmarks compared at alpha
+	order = sorted(range(len(p_values)), key=lambda i: p_values[i])
+	adjusted = [1.0] * len(p_values)
+	running = 0.0
+	for position, i in enumerate(order):
+		running = max(running, min(1.0, (len(p_values) - position) * p_values[i]))
+		adjusted[i] = running
+	return adjusted
+
+
+def main():
+	parser = argparse.ArgumentParser(
+	    "compare_results.py",
+	    description="Compare a candidate Google-Benchmark json result file against a baseline one")
+	parser.add_argument("-b", "--baseline", required=True, type=argparse.FileType("r"))
+	parser.add_argument("-c", "--candidate", required=True, type=argparse.FileType("r"))
+	parser.add_argument("-p", "--data_point_name", nargs="?", default="real_time")
+	parser.add_argument("-H", "--higher_is_better", action="store_true")
+	parser.add_argument("-a", "--alpha", type=float, default=0.01)
+	parser.add_argument("-t", "--threshold", type=float, default=0.02)
+	parser.add_argument("-f", "--filter", nargs="*", default=[])
+	parser.add_argument("-o", "--output", nargs="?")
+	args = parser.parse_args()
+
+	baseline_runs = load_repetitions(args.baseline, args.data_point_name)
+	candidate_runs = load_repetitions(args.candidate, args.data_point_name)
+
+	names = [
+	    n for n in sorted(baseline_runs)
+	    if n in candidate_runs and (len(args.filter) < 1 or any(f in n for f in args.filter))
+	]
+	skipped = []
+	results = []
+	for name in names:
+		baseline = baseline_runs[name]
+		candidate = candidate_runs[name]
+		if len(baseline) < 2 or len(candidate) < 2:
+			skipped.append(name)
+			continue
+		u, p = mann_whitney_u(baseline, candidate)
+		shift, low, high = hodges_lehmann(baseline, candidate, 1.0 - args.alpha)
+		base = median(baseline)
+		relative = (lambda x: x / base) if base != 0 else (lambda x: 0.0)
+		results.append({
+		    "name": name,
+		    "baseline_median": base,
+		    "candidate_median": median(candidate),
+		    "repetitions": [len(baseline), len(candidate)],
+		    "shift": relative(shift),
+		    "confidence_interval": [relative(low), relative(high)],
+		    "u": u,
+		    "p": p
+		})
+
+	adjusted = holm([r["p"] for r in results])
+	regressions = []
+	improvements = []
+	for r, p in zip(results, adjusted):
+		r["adjusted_p"] = p
+		worse_sign = -1.0 if args.higher_is_better else 1.0
+		low, high = r["confidence_interval"]
+		# a change must be both statistically significant and bigger than the threshold:
+		# the whole confidence interval has to be past it, not just the estimate
+		significant = p < args.alpha
+		if significant and min(low * worse_sign, high * worse_sign) > args.threshold:
+			r["verdict"] = "slower" if not args.higher_is_better else "worse"
+			regressions.append(r)
+		elif significant and max(low * worse_sign, high * worse_sign) < -args.threshold:
+			r["verdict"] = "faster" if not args.higher_is_better else "better"
+			improvements.append(r)
+		else:
+			r["verdict"] = ""
+
+	print("{:<60} {:>12} {:>12} {:>9} {:>21} {:>10}".format(
+	    "benchmark", "baseline", "candidate", "shift", "{:g}% interval".format(100 * (1 - args.alpha)),
+	    "p (holm)"))
+	for r in sorted(results, key=lambda r: r["shift"]):
+		low, high = r["confidence_interval"]
+		print("{:<60} {:>12.4g} {:>12.4g} {:>+8.2f}% {:>+9.2f}% .. {:>+7.2f}% {:>10.2g} {}".format(
+		    r["name"], r["baseline_median"], r["candidate_median"], 100 * r["shift"], 100 * low, 100 * high,
+		    r["adjusted_p"], r["verdict"]))
+	for name in skipped:
+		print("{:<60} (not enough repetitions, or an error)".format(name))
+	only_baseline = [n for n in baseline_runs if n not in candidate_runs]
+	only_candidate = [n for n in candidate_runs if n not in baseline_runs]
+	if only_baseline:
+		print("only in the baseline: " + ", ".join(sorted(only_baseline)))
+	if only_candidate:
+		print("only in the candidate: " + ", ".join(sorted(only_candidate)))
+
+	if args.output:
+		with open(args.output, "w") as f:
+			json.dump(results, f, indent="\t")
+
+	print("")
+	print("{} compared, {} significantly {}, {} significantly {} (alpha {:g}, threshold {:g}%)".format(
+	    len(results), len(regressions), "worse" if args.higher_is_better else "slower", len(improvements),
+	    "better" if args.higher_is_better else "faster", args.alpha, 100 * args.threshold))
+	return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
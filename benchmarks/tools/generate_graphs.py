@@ -134,7 +134,9 @@ def parse_json(j, data_point_names, name_removals, categories, scale,
 				point_scalar = 1 / scale
 
 		if (len(potential_targets) < 1):
-			benchmark_name = run_name.replace(category, "").strip("_")
+			# "variant_category/arguments" becomes "variant/arguments"
+			benchmark_name = run_name.replace(category, "").strip("_").replace(
+			    "_/", "/")
 			for chunk in name_removals:
 				benchmark_name = benchmark_name.replace(chunk, "")
 			all_benchmarks.append({
@@ -196,6 +198,159 @@ def parse_json(j, data_point_names, name_removals, categories, scale,
 	return aggregate_categories(all_benchmarks, data_point_names)
 
 
+def parse_scaling_json(j, scaling_categories, data_point_name):
+	# threaded benchmarks are named "<variant>_<category>/real_time/threads:N":
+	# gather the data points of each variant by thread count
+	scaling = {}
+	for j_benchmark in j["benchmarks"]:
+		name = j_benchmark['name']
+		run_name = j_benchmark['run_name']
+		if name != run_name:
+			# a statistic: recomputed below from the data points themselves
+			continue
+		potential_categories = [c for c in scaling_categories if c in run_name]
+		if len(potential_categories) < 1:
+			continue
+		potential_categories.sort(key=len_sorter, reverse=True)
+		category = potential_categories[0]
+		variant_name = run_name.split("/")[0].replace(category, "").strip("_")
+		threads = j_benchmark.get('threads', 1)
+		variants = scaling.setdefault(category, {})
+		variant = variants.setdefault(variant_name, {
+		    "data": {},
+		    "error": None
+		})
+		benchmark_error = j_benchmark.get('error_occurred')
+		if benchmark_error != None and benchmark_error:
+			variant["error"] = j_benchmark['error_message']
+			continue
+		point = j_benchmark.get(data_point_name)
+		if point == None:
+			continue
+		variant["data"].setdefault(threads, []).append(point)
+	return scaling
+
+
+def parse_counters_json(j, categories, counter_names):
+	# the user counters (such as hardware performance counters) of each benchmark,
+	# which are already averaged per iteration
+	counters = {}
+	for j_benchmark in j["benchmarks"]:
+		name = j_benchmark['name']
+		run_name = j_benchmark['run_name']
+		if name != run_name:
+			continue
+		benchmark_error = j_benchmark.get('error_occurred')
+		if benchmark_error != None and benchmark_error:
+			continue
+		potential_categories = [c for c in categories if c in run_name]
+		if len(potential_categories) < 1:
+			continue
+		potential_categories.sort(key=len_sorter, reverse=True)
+		category = potential_categories[0]
+		benchmark_name = run_name.replace(category, "").strip("_")
+		for counter_name in counter_names:
+			point = j_benchmark.get(counter_name)
+			if point == None:
+				continue
+			category_counters = counters.setdefault(category, {})
+			counter = category_counters.setdefault(counter_name, {})
+			counter.setdefault(benchmark_name, []).append(point)
+	return counters
+
+
+def draw_counters_graph(name, counters, counter_names):
+	present_names = [c for c in counter_names if c in counters]
+	figures, axes_list = plt.subplots(
+	    1,
+	    len(present_names),
+	    squeeze=False,
+	    sharey=True,
+	    figsize=(3.2 * len(present_names) + 1.6, 4.8))
+	benchmark_names = sorted(
+	    set(b for c in present_names for b in counters[c]))
+	y_positions = list(range(len(benchmark_names)))
+	for axes, counter_name in zip(axes_list[0], present_names):
+		counter = counters[counter_name]
+		means = []
+		stddevs = []
+		for benchmark_name in benchmark_names:
+			data = counter.get(benchmark_name, [])
+			mean = sum(data) / len(data) if len(data) > 0 else 0
+			means.append(mean)
+			stddevs.append(
+			    math.sqrt(
+			        sum((x - mean)**2
+			            for x in data) / max(len(data) - 1, 1)))
+		axes.barh(
+		    y_positions,
+		    means,
+		    xerr=stddevs,
+		    color='#a6cee3',
+		    edgecolor='#3d6f87',
+		    linewidth=0.2,
+		    error_kw={
+		        "capsize": 3.0,
+		        "ecolor": 'black',
+		    },
+		    alpha=0.82)
+		axes.set_xlim(left=0)
+		axes.set_title(counter_name, fontsize='medium')
+		axes.xaxis.set_major_formatter(mticker.EngFormatter())
+		axes.tick_params(axis='x', labelsize='small')
+		axes.grid(True, axis='x', linestyle=':', linewidth=0.5)
+	axes_list[0][0].set_yticks(y_positions)
+	axes_list[0][0].set_yticklabels(benchmark_names)
+	figures.suptitle(name + ' - per iteration, lower is better')
+	figures.tight_layout()
+
+	return figures, axes_list
+
+
+def draw_scaling_graph(name, variants, data_point_name, lower_is_better):
+	figures, axes = plt.subplots()
+
+	all_threads = set()
+	for variant_name in sorted(variants):
+		variant = variants[variant_name]
+		data = variant["data"]
+		if variant["error"] != None or len(data) < 1:
+			continue
+		threads = sorted(data)
+		all_threads.update(threads)
+		means = [sum(data[t]) / len(data[t]) for t in threads]
+		stddevs = [
+		    math.sqrt(
+		        sum((x - m)**2 for x in data[t]) / max(len(data[t]) - 1, 1))
+		    for t, m in zip(threads, means)
+		]
+		axes.errorbar(
+		    threads,
+		    means,
+		    yerr=stddevs,
+		    label=variant_name,
+		    marker='o',
+		    markersize=4,
+		    capsize=3.0,
+		    linewidth=1.2,
+		    alpha=0.82)
+
+	axes.set_xscale('log', base=2)
+	axes.set_xticks(sorted(all_threads))
+	axes.xaxis.set_major_formatter(mticker.FormatStrFormatter('%d'))
+	axes.yaxis.set_major_formatter(mticker.EngFormatter())
+	axes.set_ylim(bottom=0)
+	axes.set_xlabel('threads')
+	axes.set_ylabel(data_point_name + ' - ' +
+	                ('lower is better' if lower_is_better else 'higher is better'))
+	axes.grid(True, which='major', linestyle=':', linewidth=0.5)
+	axes.legend(fontsize='small')
+	axes.set_title(name)
+	figures.tight_layout()
+
+	return figures, axes
+
+
 def draw_graph(name, category, benchmarks_heuristics, data_point_names,
                time_scales):
 	# initialize figures
@@ -260,7 +415,9 @@ def draw_graph(name, category, benchmarks_heuristics, data_point_names,
 			err = benchmark.get('error')
 
 			color_index = benchmark["color_index"][data_point_name]
-			aesthetics = data_point_aesthetics[color_index]
+			# categories with many variants re-use the palette
+			aesthetics = data_point_aesthetics[color_index %
+			                                   len(data_point_aesthetics)]
 			color = aesthetics[0]
 			colorhsv = matplotlib.colors.rgb_to_hsv(
 			    matplotlib.colors.hex2color(color))
@@ -405,6 +562,10 @@ def main():
 	parser.add_argument('-t', '--scale_categories', nargs='+', default=[])
 	parser.add_argument('-r', '--remove_from_names', nargs='+', default=[''])
 	parser.add_argument('-z', '--time_format', nargs='?', default='clock')
+	parser.add_argument('-g', '--scaling_categories', nargs='+', default=[])
+	parser.add_argument(
+	    '-y', '--scaling_data_point', nargs='?', default='items_per_second')
+	parser.add_argument('-k', '--counters', nargs='+', default=[])
 
 	args = parser.parse_args()
 
@@ -468,6 +629,8 @@ def main():
 		sys.exit(1)
 
 	benchmarks = None
+	scaling = {}
+	counters = {}
 	if is_csv:
 		c = csv.reader(args.input)
 		benchmarks = parse_csv(c, data_point_names, name_removals,
@@ -478,6 +641,11 @@ def main():
 		benchmarks = parse_json(j, data_point_names, name_removals,
 		                        args.categories, args.scale,
 		                        args.scale_categories, clock_time_scales)
+		scaling = parse_scaling_json(j, args.scaling_categories,
+		                             args.scaling_data_point)
+		counters = parse_counters_json(
+		    j, [c for c in args.categories if c not in args.scaling_categories],
+		    args.counters)
 	else:
 		return
 
@@ -486,6 +654,9 @@ def main():
 	for benchmarks_key in benchmarks:
 		b = benchmarks[benchmarks_key]
 		category = benchmarks_key
+		if category in args.scaling_categories:
+			# drawn as curves over the thread count, below
+			continue
 		if category == None or len(category) < 1:
 			category = name
 		benchmark_name = category.replace("_measure",
@@ -499,6 +670,27 @@ def main():
 		plt.savefig(savetarget, format='png')
 		plt.close(figures)
 
+	# draw the counters of each category, side by side
+	for category in counters:
+		benchmark_name = category.replace("_", " ").strip() + " counters"
+		figures, axes = draw_counters_graph(benchmark_name, counters[category],
+		                                    args.counters)
+		savetarget = os.path.join(args.output_dir, benchmark_name + '.png')
+		print("Saving graph: {} (to '{}')".format(benchmark_name, savetarget))
+		plt.savefig(savetarget, format='png')
+		plt.close(figures)
+
+	# draw scaling curves for each threaded category
+	for category in scaling:
+		benchmark_name = category.replace("_", " ").strip()
+		figures, axes = draw_scaling_graph(
+		    benchmark_name, scaling[category], args.scaling_data_point,
+		    args.scaling_data_point in args.lower)
+		savetarget = os.path.join(args.output_dir, benchmark_name + '.png')
+		print("Saving graph: {} (to '{}')".format(benchmark_name, savetarget))
+		plt.savefig(savetarget, format='png')
+		plt.close(figures)
+
 
 if __name__ == "__main__":
 	main()
\ No newline at end of file
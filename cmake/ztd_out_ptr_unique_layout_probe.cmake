@@ -0,0 +1,59 @@
+#  Copyright ⓒ 2018-2023 ThePhD.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+#  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+# Measures where std::unique_ptr stores its pointer for stateful and reference deleters,
+# and writes the result to a header that the clever out_ptr / inout_ptr paths read.
+# Sets ZTD_OUT_PTR_UNIQUE_LAYOUT_PROBE_INCLUDE_DIR if the probe could be run.
+
+set(ztd_out_ptr_unique_layout_probe_dir "${CMAKE_CURRENT_BINARY_DIR}/unique_layout_probe")
+try_run(ztd_out_ptr_unique_layout_probe_run ztd_out_ptr_unique_layout_probe_compile
+	"${ztd_out_ptr_unique_layout_probe_dir}"
+	"${CMAKE_CURRENT_LIST_DIR}/ztd_out_ptr_unique_layout_probe.cpp"
+	CMAKE_FLAGS -DCMAKE_CXX_STANDARD=11 -DCMAKE_CXX_STANDARD_REQUIRED=ON
+	COMPILE_OUTPUT_VARIABLE ztd_out_ptr_unique_layout_probe_compile_output
+	RUN_OUTPUT_VARIABLE ztd_out_ptr_unique_layout_probe_output
+)
+
+if (NOT ztd_out_ptr_unique_layout_probe_compile
+	OR NOT ztd_out_ptr_unique_layout_probe_run EQUAL 0
+	OR NOT ztd_out_ptr_unique_layout_probe_output MATCHES "^([^ ]+) ([0-9]+) ([0-9]+) ([0-9]+) ([0-9]+)")
+	message(STATUS "ztd.out_ptr: could not probe the std::unique_ptr layout; the clever paths will use the built-in defaults")
+	return()
+endif()
+
+set(ztd_out_ptr_probed_stdlib_name "${CMAKE_MATCH_1}")
+set(ZTD_OUT_PTR_PROBED_UNIQUE_STATEFUL_OFFSET "${CMAKE_MATCH_2}")
+set(ZTD_OUT_PTR_PROBED_UNIQUE_STATEFUL_SIZE "${CMAKE_MATCH_3}")
+set(ZTD_OUT_PTR_PROBED_UNIQUE_REFERENCE_OFFSET "${CMAKE_MATCH_4}")
+set(ZTD_OUT_PTR_PROBED_UNIQUE_REFERENCE_SIZE "${CMAKE_MATCH_5}")
+# must match ZTD_OUT_PTR_STDLIB_I_ in ztd/out_ptr/version.hpp
+if (ztd_out_ptr_probed_stdlib_name STREQUAL "libstdc++")
+	set(ZTD_OUT_PTR_PROBED_UNIQUE_STDLIB 1)
+elseif (ztd_out_ptr_probed_stdlib_name STREQUAL "libc++")
+	set(ZTD_OUT_PTR_PROBED_UNIQUE_STDLIB 2)
+elseif (ztd_out_ptr_probed_stdlib_name STREQUAL "msvc-stl")
+	set(ZTD_OUT_PTR_PROBED_UNIQUE_STDLIB 3)
+else()
+	set(ZTD_OUT_PTR_PROBED_UNIQUE_STDLIB 0)
+endif()
+
+set(ZTD_OUT_PTR_UNIQUE_LAYOUT_PROBE_INCLUDE_DIR "${ztd_out_ptr_unique_layout_probe_dir}/include")
+configure_file("${CMAKE_CURRENT_LIST_DIR}/ztd_out_ptr_unique_layout_probe.hpp.in"
+	"${ZTD_OUT_PTR_UNIQUE_LAYOUT_PROBE_INCLUDE_DIR}/ztd/out_ptr/detail/unique_layout_probe.hpp"
+	@ONLY)
+message(STATUS "ztd.out_ptr: std::unique_ptr layout (${ztd_out_ptr_probed_stdlib_name}): "
+	"stateful deleter pointer offset ${ZTD_OUT_PTR_PROBED_UNIQUE_STATEFUL_OFFSET}, "
+	"reference deleter pointer offset ${ZTD_OUT_PTR_PROBED_UNIQUE_REFERENCE_OFFSET}")
@@ -0,0 +1,73 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+// Configure-time probe: measures where std::unique_ptr keeps its pointer for
+// each kind of deleter on the standard library being built against.
+// Prints "<stdlib> <stateful offset> <stateful size> <reference offset> <reference size>".
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+
+namespace {
+	// odd size and alignment 1: "pointer first" and "deleter first" layouts
+	// put the pointer at different offsets for this deleter
+	struct probe_deleter {
+		unsigned char state[12];
+
+		void operator()(int*) const {
+		}
+	};
+
+	template <typename Smart>
+	long pointer_offset(const Smart& smart, int* sentinel) {
+		unsigned char bytes[sizeof(Smart)];
+		std::memcpy(bytes, static_cast<const void*>(&smart), sizeof(Smart));
+		for (std::size_t offset = 0; offset + sizeof(int*) <= sizeof(Smart); offset += alignof(int*)) {
+			if (std::memcmp(bytes + offset, &sentinel, sizeof(int*)) == 0) {
+				return static_cast<long>(offset);
+			}
+		}
+		return -1;
+	}
+} // namespace
+
+int main() {
+	int* sentinel = reinterpret_cast<int*>(static_cast<std::uintptr_t>(0x5A5A5A50u));
+	probe_deleter deleter = {};
+	std::memset(deleter.state, 0xA5, sizeof(deleter.state));
+
+	std::unique_ptr<int, probe_deleter> stateful(sentinel, deleter);
+	std::unique_ptr<int, probe_deleter&> reference(sentinel, deleter);
+	long stateful_offset  = pointer_offset(stateful, sentinel);
+	long reference_offset = pointer_offset(reference, sentinel);
+	stateful.release();
+	reference.release();
+
+#if defined(_LIBCPP_VERSION)
+	const char* stdlib = "libc++";
+#elif defined(__GLIBCXX__)
+	const char* stdlib = "libstdc++";
+#elif defined(_CPPLIB_VER) || defined(_YVALS)
+	const char* stdlib = "msvc-stl";
+#else
+	const char* stdlib = "unknown";
+#endif
+	std::printf("%s %ld %lu %ld %lu\n", stdlib, stateful_offset, static_cast<unsigned long>(sizeof(stateful)), reference_offset, static_cast<unsigned long>(sizeof(reference)));
+	return (stateful_offset < 0 || reference_offset < 0) ? 1 : 0;
+}
@@ -39,6 +39,7 @@ void COM_folder_check() {
 	// along with the "false" argument to
 	// not AddRef when putting
 	// the output parameter into the intrusive_ptr
+	// (CoCreateInstance writes straight into dispatch_ptr's storage)
 	HRESULT cci_result = CoCreateInstance(clsid, 0, CLSCTX_INPROC_SERVER,
 		__uuidof(IDispatch), ztd::out_ptr::out_ptr<void*>(dispatch_ptr, false));
 	if (FAILED(cci_result)) {
@@ -24,17 +24,19 @@
 #include <iostream>
 
 int main(int, char*[]) {
-	using zop = ztd::out_ptr;
+	namespace zop = ztd::out_ptr;
 
 	std::shared_ptr<sqlite3> database;
 
-	if (SQLITE_OK != sqlite3_open("test.db", pop::out_ptr(database, sqlite3_close))) {
+	if (SQLITE_OK != sqlite3_open("test.db", zop::out_ptr(database, sqlite3_close))) {
 		std::cout << "Problem opening the file";
 	}
 
-	using Sqlite3Ptr = std::unique_ptr<sqlite3, decltype(&sqlite3_close)>;
-	Sqlite3Ptr database2(nullptr, &sqlite3_close);
-	if (SQLITE_OK != sqlite3_open("test.db", pop::out_ptr(database2, sqlite3_close))) {
+	// the size of a sqlite3*, and sqlite3_close is called directly:
+	// no function pointer is stored next to the handle
+	using Sqlite3Ptr = zop::basic_c_handle<sqlite3, decltype(&sqlite3_close), &sqlite3_close>;
+	Sqlite3Ptr database2;
+	if (SQLITE_OK != sqlite3_open("test.db", zop::out_ptr(database2))) {
 		std::cout << "Problem opening the file";
 	}
 
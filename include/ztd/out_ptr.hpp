@@ -21,5 +21,23 @@
 
 #include <ztd/out_ptr/out_ptr.hpp>
 #include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/ownership_policy.hpp>
+#include <ztd/out_ptr/is_intrusive_handle.hpp>
+#include <ztd/out_ptr/static_deleter.hpp>
+#include <ztd/out_ptr/lazy_arg.hpp>
+#include <ztd/out_ptr/commits_null_as_empty.hpp>
+#include <ztd/out_ptr/batch_out_ptr.hpp>
+#include <ztd/out_ptr/array_out_ptr.hpp>
+#include <ztd/out_ptr/out_ptrs.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+#include <ztd/out_ptr/deferred_out_ptr.hpp>
+#include <ztd/out_ptr/pooled_handle.hpp>
+#include <ztd/out_ptr/arena_handle.hpp>
+#include <ztd/out_ptr/atomic_shared_ptr.hpp>
+#include <ztd/out_ptr/epoch_handle.hpp>
+#include <ztd/out_ptr/shared_handle.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+#include <ztd/out_ptr/aliasing_out_ptr.hpp>
+#include <ztd/out_ptr/thread_pooled_allocator.hpp>
 
 #endif
@@ -0,0 +1,113 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_ALIASING_OUT_PTR_HPP
+#define ZTD_OUT_PTR_ALIASING_OUT_PTR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
+#include <ztd/out_ptr/detail/customization_forward.hpp>
+#include <ztd/out_ptr/detail/is_specialization_of.hpp>
+#include <ztd/out_ptr/detail/integer_sequence.hpp>
+#include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+namespace ztd { namespace out_ptr {
+
+	namespace op_detail {
+		// commits a pointer into memory which `owner` keeps alive (a statement owned by its
+		// connection, a view into a buffer) through the aliasing constructor: the output shares
+		// the owner's control block, rather than getting one of its own with a no-op deleter
+		template <typename Smart, typename Pointer>
+		class aliasing_out_ptr_traits {
+		private:
+			using source_pointer = pointer_of_or_t<Smart, Pointer>;
+
+		public:
+			using pointer = Pointer;
+
+			template <typename Owner>
+			static pointer construct(Smart&, Owner&&) noexcept {
+				static_assert(is_specialization_of<Smart, std::shared_ptr>::value || is_specialization_of<Smart, boost::shared_ptr>::value,
+					"aliasing_out_ptr only works with shared_ptr-like types");
+				static_assert((is_specialization_of<Smart, std::shared_ptr>::value && is_specialization_of<typename std::decay<Owner>::type, std::shared_ptr>::value)
+						|| (is_specialization_of<Smart, boost::shared_ptr>::value && is_specialization_of<typename std::decay<Owner>::type, boost::shared_ptr>::value),
+					"the owner passed to aliasing_out_ptr must be the same kind of shared_ptr as the one written into");
+				return pointer();
+			}
+
+			static Pointer* get(Smart&, pointer& p) noexcept {
+				return std::addressof(p);
+			}
+
+			// a null output does not keep the owner alive: it is committed as an empty handle
+			template <typename Owner>
+			static void reset(Smart& s, pointer& p, Owner&& owner) noexcept {
+				if (p == pointer()) {
+					s.reset();
+					return;
+				}
+				// an rvalue owner gives up its reference rather than adding one (C++20)
+				s = Smart(std::forward<Owner>(owner), static_cast<source_pointer>(p));
+			}
+		};
+	} // namespace op_detail
+
+	template <typename Smart, typename Pointer, typename Owner>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ aliasing_out_ptr_t
+	: public op_detail::base_out_ptr_impl<Smart, Pointer, op_detail::aliasing_out_ptr_traits<Smart, Pointer>, std::tuple<Owner>, ztd::out_ptr::op_detail::make_index_sequence<1>> {
+	private:
+		using traits_t = op_detail::aliasing_out_ptr_traits<Smart, Pointer>;
+		using core_t   = op_detail::base_out_ptr_impl<Smart, Pointer, traits_t, std::tuple<Owner>, ztd::out_ptr::op_detail::make_index_sequence<1>>;
+
+	public:
+		aliasing_out_ptr_t(Smart& s, Owner owner) noexcept
+		: core_t(s, std::forward_as_tuple(std::forward<Owner>(owner))) {
+		}
+	};
+
+	namespace op_detail {
+		template <typename Pointer, typename Smart, typename Owner>
+		aliasing_out_ptr_t<Smart, Pointer, Owner> aliasing_out_ptr_tagged(std::false_type, Smart& s, Owner&& owner) noexcept {
+			using P = aliasing_out_ptr_t<Smart, Pointer, Owner>;
+			return P(s, std::forward<Owner>(owner));
+		}
+
+		template <typename, typename Smart, typename Owner>
+		aliasing_out_ptr_t<Smart, pointer_of_t<Smart>, Owner> aliasing_out_ptr_tagged(std::true_type, Smart& s, Owner&& owner) noexcept {
+			using Pointer = pointer_of_t<Smart>;
+			using P	    = aliasing_out_ptr_t<Smart, Pointer, Owner>;
+			return P(s, std::forward<Owner>(owner));
+		}
+	} // namespace op_detail
+
+	template <typename Pointer = op_detail::marker, typename Smart, typename Owner>
+	auto aliasing_out_ptr(Smart& s, Owner&& owner) noexcept
+		-> decltype(op_detail::aliasing_out_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Owner>(owner))) {
+		return op_detail::aliasing_out_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Owner>(owner));
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,304 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_ARENA_HANDLE_HPP
+#define ZTD_OUT_PTR_ARENA_HANDLE_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/inout_ptr_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ztd { namespace out_ptr {
+
+	// Calls a batch destroy function fixed at compile time, e.g. glDeleteTextures or
+	// a library's destroy_many, once with every object an arena owns.
+	template <typename F, F Destroy>
+	struct basic_batch_destroy {
+		template <typename Pointer>
+		void operator()(Pointer* first, std::size_t n) const {
+			(void)Destroy(first, n);
+		}
+	};
+
+#if ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_
+	template <auto Destroy>
+	using batch_destroy = basic_batch_destroy<decltype(Destroy), Destroy>;
+#endif // auto template parameters
+
+	// Forgets the objects instead of destroying them: for C objects which live in memory
+	// the C library frees all at once by itself, e.g. an APR pool or a talloc context.
+	struct no_batch_destroy {
+		template <typename Pointer>
+		void operator()(Pointer*, std::size_t) const noexcept {
+		}
+	};
+
+	// Owns every C object committed into one of its arena_handles, and destroys them all
+	// at once: one call to BatchDestroy with every live object, in the order they were
+	// committed, instead of one deleter call per handle (see basic_batch_destroy and
+	// no_batch_destroy).
+	// Handles must not be used once the arena is released or gone.
+	template <typename Pointer, typename BatchDestroy>
+	class handle_arena {
+	public:
+		using pointer			   = Pointer;
+		using batch_destroy_type = BatchDestroy;
+
+	private:
+		template <typename>
+		friend class arena_handle;
+		template <typename, typename>
+		friend class out_ptr_traits;
+		template <typename, typename>
+		friend class inout_ptr_traits;
+
+		std::vector<pointer> m_slots;
+		// slots emptied by an inout_ptr C function which freed its input and wrote null
+		std::size_t m_holes;
+		batch_destroy_type m_destroy;
+
+		std::size_t adopt(pointer p) {
+			m_slots.push_back(p);
+			return m_slots.size();
+		}
+
+		// records an empty slot before the C function is called, so that filling it in
+		// afterwards cannot fail
+		std::size_t reserve_slot() {
+			m_slots.push_back(pointer());
+			++m_holes;
+			return m_slots.size();
+		}
+
+		void fill(std::size_t slot, pointer p) noexcept {
+			if (p == pointer()) {
+				return;
+			}
+			--m_holes;
+			m_slots[slot - 1] = p;
+		}
+
+		void replace(std::size_t slot, pointer p) noexcept {
+			pointer& target = m_slots[slot - 1];
+			if (p == pointer()) {
+				++m_holes;
+			}
+			target = p;
+		}
+
+	public:
+		handle_arena() : handle_arena(batch_destroy_type()) {
+			static_assert(!std::is_pointer<batch_destroy_type>::value, "a batch destroy function pointer must be given to the arena's constructor");
+		}
+
+		explicit handle_arena(batch_destroy_type destroy) : m_slots(), m_holes(0), m_destroy(std::move(destroy)) {
+		}
+
+		handle_arena(const handle_arena&)			 = delete;
+		handle_arena& operator=(const handle_arena&) = delete;
+
+		~handle_arena() {
+			release();
+		}
+
+		// makes room for n more objects, so committing them does not allocate
+		void reserve(std::size_t n) {
+			m_slots.reserve(m_slots.size() + n);
+		}
+
+		std::size_t size() const noexcept {
+			return m_slots.size() - m_holes;
+		}
+
+		// destroys every object, and keeps the memory the records took for the next round
+		void release() noexcept {
+			if (m_holes != 0) {
+				m_slots.erase(std::remove(m_slots.begin(), m_slots.end(), pointer()), m_slots.end());
+				m_holes = 0;
+			}
+			if (m_slots.empty()) {
+				return;
+			}
+			(void)m_destroy(m_slots.data(), m_slots.size());
+			m_slots.clear();
+		}
+	};
+
+	// A view of one object owned by a handle_arena: it never destroys anything, and
+	// committing into it through out_ptr records the new object in the arena. It is
+	// move-only, since inout_ptr through one copy would leave the other dangling.
+	template <typename Arena>
+	class arena_handle {
+	public:
+		using arena_type	 = Arena;
+		using pointer		 = typename Arena::pointer;
+		using element_type = typename std::remove_pointer<pointer>::type;
+
+	private:
+		template <typename, typename>
+		friend class out_ptr_traits;
+		template <typename, typename>
+		friend class inout_ptr_traits;
+
+		Arena* m_arena;
+		pointer m_ptr;
+		// 1 + the index of this handle's record in the arena, or 0 when empty
+		std::size_t m_slot;
+
+	public:
+		explicit arena_handle(Arena& arena) noexcept : m_arena(std::addressof(arena)), m_ptr(), m_slot(0) {
+		}
+
+		arena_handle(Arena& arena, pointer p) : arena_handle(arena) {
+			reset(p);
+		}
+
+		arena_handle(arena_handle&& right) noexcept : m_arena(right.m_arena), m_ptr(right.m_ptr), m_slot(right.m_slot) {
+			right.reset();
+		}
+
+		arena_handle& operator=(arena_handle&& right) noexcept {
+			m_arena = right.m_arena;
+			m_ptr	  = right.m_ptr;
+			m_slot  = right.m_slot;
+			right.reset();
+			return *this;
+		}
+
+		arena_handle(const arena_handle&)			 = delete;
+		arena_handle& operator=(const arena_handle&) = delete;
+
+		pointer get() const noexcept {
+			return m_ptr;
+		}
+
+		pointer operator->() const noexcept {
+			return m_ptr;
+		}
+
+		explicit operator bool() const noexcept {
+			return m_ptr != pointer();
+		}
+
+		Arena& arena() const noexcept {
+			return *m_arena;
+		}
+
+		// the previous object stays in the arena until the arena is released
+		void reset(pointer p) {
+			if (p == pointer()) {
+				reset();
+				return;
+			}
+			m_slot = m_arena->adopt(p);
+			m_ptr  = p;
+		}
+
+		void reset() noexcept {
+			m_ptr  = pointer();
+			m_slot = 0;
+		}
+	};
+
+	namespace op_detail {
+		// the output, next to the arena slot recorded for it before the call
+		template <typename Pointer>
+		struct arena_slot_storage {
+			Pointer target;
+			std::size_t slot;
+		};
+	} // namespace op_detail
+
+	template <typename Pointer, typename BatchDestroy, typename OutPointer>
+	class out_ptr_traits<arena_handle<handle_arena<Pointer, BatchDestroy>>, OutPointer> {
+	private:
+		using smart_t = arena_handle<handle_arena<Pointer, BatchDestroy>>;
+
+	public:
+		using pointer = op_detail::arena_slot_storage<OutPointer>;
+
+		// the arena's record may allocate: it is made here, where a failure is thrown before the
+		// C function is called, rather than in the commit. handle_arena::reserve avoids it
+		static pointer construct(smart_t& s) {
+			return pointer { OutPointer(), s.m_arena->reserve_slot() };
+		}
+
+		static typename std::add_pointer<OutPointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p.target);
+		}
+
+		static void reset(smart_t& s, pointer& p) noexcept {
+			Pointer committed = static_cast<Pointer>(p.target);
+			s.m_arena->fill(p.slot, committed);
+			if (committed == Pointer()) {
+				s.reset();
+				return;
+			}
+			s.m_ptr	= committed;
+			s.m_slot = p.slot;
+		}
+	};
+
+	template <typename Pointer, typename BatchDestroy, typename InoutPointer>
+	class inout_ptr_traits<arena_handle<handle_arena<Pointer, BatchDestroy>>, InoutPointer> {
+	private:
+		using smart_t = arena_handle<handle_arena<Pointer, BatchDestroy>>;
+
+	public:
+		using pointer = op_detail::arena_slot_storage<InoutPointer>;
+
+		// an empty handle has no record yet: one is made before the call, as out_ptr does
+		static pointer construct(smart_t& s) {
+			return pointer { static_cast<InoutPointer>(s.get()), s.m_slot == 0 ? s.m_arena->reserve_slot() : s.m_slot };
+		}
+
+		static typename std::add_pointer<InoutPointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p.target);
+		}
+
+		// the C function was given the arena's object, and either re-used it, moved it or freed
+		// it: the object it wrote back takes over that object's record rather than adding one
+		static void reset(smart_t& s, pointer& p) noexcept {
+			Pointer committed = static_cast<Pointer>(p.target);
+			if (s.m_slot == 0) {
+				s.m_arena->fill(p.slot, committed);
+				if (committed != Pointer()) {
+					s.m_ptr	= committed;
+					s.m_slot = p.slot;
+				}
+				return;
+			}
+			s.m_arena->replace(s.m_slot, committed);
+			if (committed == Pointer()) {
+				s.reset();
+				return;
+			}
+			s.m_ptr = committed;
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,155 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_ARRAY_OUT_PTR_HPP
+#define ZTD_OUT_PTR_ARRAY_OUT_PTR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
+#include <ztd/out_ptr/detail/array_out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
+#include <ztd/out_ptr/detail/voidpp_op.hpp>
+#include <ztd/out_ptr/detail/integer_sequence.hpp>
+#include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
+#include <cassert>
+#endif // assert for sanity checks
+
+namespace ztd { namespace out_ptr {
+
+	namespace op_detail {
+
+		// contiguous integral handles are an array of their values already:
+		// empty them all, let the C function write over them, then destroy the old values
+		template <typename Array, typename Pointer>
+		class ZTD_OUT_PTR_TRIVIAL_ABI_I_ array_integral_fast : public voidpp_op<array_integral_fast<Array, Pointer>, Pointer> {
+		private:
+			static constexpr const std::size_t N = array_extent<Array>::size;
+
+			Array* m_array_ptr;
+			std::array<Pointer, N> m_old_values;
+
+		public:
+			array_integral_fast(Array& a, std::tuple<>&&) noexcept
+			: m_array_ptr(std::addressof(a)), m_old_values() {
+				Pointer* target = static_cast<Pointer*>(static_cast<void*>(std::addressof(a[0])));
+				for (std::size_t i = 0; i < N; ++i) {
+					this->m_old_values[i] = a[i].get();
+#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
+					assert(target[i] == this->m_old_values[i] && "clever UB-based optimization did not properly retrieve the handle value");
+#endif // Clever Sanity Checks
+					target[i] = handle_null<Pointer>(a[i]);
+				}
+			}
+			array_integral_fast(array_integral_fast&& right) noexcept
+			: m_array_ptr(right.m_array_ptr), m_old_values(right.m_old_values) {
+				right.m_array_ptr = nullptr;
+			}
+			array_integral_fast& operator=(array_integral_fast&& right) noexcept {
+				this->m_array_ptr  = right.m_array_ptr;
+				this->m_old_values = right.m_old_values;
+				right.m_array_ptr  = nullptr;
+				return *this;
+			}
+
+			operator Pointer*() const noexcept {
+				return static_cast<Pointer*>(static_cast<void*>(std::addressof((*this->m_array_ptr)[0])));
+			}
+
+			~array_integral_fast() noexcept {
+				if (this->m_array_ptr == nullptr) {
+					return;
+				}
+				Array& a = *this->m_array_ptr;
+				for (std::size_t i = 0; i < N; ++i) {
+					if (!handle_is_null(a[i], this->m_old_values[i])) {
+						a[i].get_deleter()(this->m_old_values[i]);
+					}
+				}
+			}
+		};
+
+		template <typename Array, typename Pointer, typename... Args>
+		using array_base_out_ptr_t = base_out_ptr_impl<Array, Pointer, array_out_ptr_traits<Array, Pointer>, std::tuple<Args...>, ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>>;
+
+		template <typename Array, typename Pointer, typename... Args>
+		struct select_core_array_out_ptr {
+			using type = array_base_out_ptr_t<Array, Pointer, Args...>;
+		};
+
+		template <typename Array, typename Pointer>
+		struct select_core_array_out_ptr<Array, Pointer> {
+			using type = typename std::conditional<ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ != 0
+					&& is_integral_handle<array_value_t<Array>, Pointer>::value
+					&& has_unspecialized_marker<array_out_ptr_traits<Array, Pointer>>::value
+					&& has_unspecialized_marker<out_ptr_traits<array_value_t<Array>, Pointer>>::value,
+				array_integral_fast<Array, Pointer>, array_base_out_ptr_t<Array, Pointer>>::type;
+		};
+	} // namespace op_detail
+
+	template <typename Array, typename Pointer, typename... Args>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ array_out_ptr_t : public op_detail::select_core_array_out_ptr<Array, Pointer, Args...>::type {
+	private:
+		using core_t = typename op_detail::select_core_array_out_ptr<Array, Pointer, Args...>::type;
+
+	public:
+		array_out_ptr_t(Array& a, Args... args) noexcept
+		: core_t(a, std::forward_as_tuple(std::forward<Args>(args)...)) {
+		}
+	};
+
+	namespace op_detail {
+		template <typename Pointer, typename Array, typename... Args>
+		array_out_ptr_t<Array, Pointer, Args...> array_out_ptr_tagged(std::false_type, Array& a, Args&&... args) noexcept {
+			using P = array_out_ptr_t<Array, Pointer, Args...>;
+			return P(a, std::forward<Args>(args)...);
+		}
+
+		template <typename, typename Array, typename... Args>
+		array_out_ptr_t<Array, pointer_of_t<array_value_t<Array>>, Args...> array_out_ptr_tagged(std::true_type, Array& a, Args&&... args) noexcept {
+			using Pointer = pointer_of_t<array_value_t<Array>>;
+			using P	    = array_out_ptr_t<Array, Pointer, Args...>;
+			return P(a, std::forward<Args>(args)...);
+		}
+
+		// always through the scratch array and .reset(...), even for integral handles
+		template <typename Pointer = marker, typename Array, typename... Args>
+		array_base_out_ptr_t<Array, typename std::conditional<std::is_same<Pointer, marker>::value, pointer_of_t<array_value_t<Array>>, Pointer>::type, Args...> simple_array_out_ptr(Array& a, Args&&... args) noexcept {
+			return { a, std::forward_as_tuple(std::forward<Args>(args)...) };
+		}
+
+	} // namespace op_detail
+
+	// for C functions which write a fixed number of outputs, e.g. pipe(int[2])
+	template <typename Pointer = op_detail::marker, typename Array, typename... Args>
+	auto array_out_ptr(Array& a, Args&&... args) noexcept
+		-> decltype(op_detail::array_out_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), a, std::forward<Args>(args)...)) {
+		return op_detail::array_out_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), a, std::forward<Args>(args)...);
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
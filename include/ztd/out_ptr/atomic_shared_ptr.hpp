@@ -0,0 +1,81 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_ATOMIC_SHARED_PTR_HPP
+#define ZTD_OUT_PTR_ATOMIC_SHARED_PTR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/necessary_arity.hpp>
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace out_ptr {
+
+	// Publishing to many readers: every reader shares ownership of what it loads, so an object
+	// which is replaced lives on for as long as a reader still holds it. For readers which look
+	// objects up without taking a reference, see epoch_handle.
+#if ZTD_OUT_PTR_HAS_ATOMIC_SHARED_PTR_I_
+	template <typename T>
+	struct pointer_of<std::atomic<std::shared_ptr<T>>> {
+		using type = typename std::shared_ptr<T>::element_type*;
+	};
+
+	// like std::shared_ptr, needs a deleter to build the control block with
+	template <typename T, typename... Args>
+	class necessary_arity<std::atomic<std::shared_ptr<T>>, Args...> : public std::integral_constant<std::size_t, 1> { };
+
+	// builds the shared_ptr (and its control block) first, then publishes it with one release store
+	template <typename T, typename Pointer>
+	class out_ptr_traits<std::atomic<std::shared_ptr<T>>, Pointer> {
+	private:
+		using smart_t		  = std::atomic<std::shared_ptr<T>>;
+		using source_pointer = typename std::shared_ptr<T>::element_type*;
+
+	public:
+		using pointer = Pointer;
+
+		template <typename... Args>
+		static pointer construct(smart_t&, Args&&...) noexcept {
+			return pointer();
+		}
+
+		static typename std::add_pointer<pointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p);
+		}
+
+		template <typename... Args>
+		static void reset(smart_t& s, pointer& p, Args&&... args) noexcept {
+			if (p == pointer()) {
+				// no control block, and no deleter call, for a null output
+				s.store(std::shared_ptr<T>(), std::memory_order_release);
+				return;
+			}
+			s.store(std::shared_ptr<T>(static_cast<source_pointer>(p), op_detail::materialize(std::forward<Args>(args))...), std::memory_order_release);
+		}
+	};
+#endif // atomic shared_ptr
+
+}} // namespace ztd::out_ptr
+
+#endif
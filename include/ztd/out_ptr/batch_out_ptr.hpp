@@ -0,0 +1,77 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_BATCH_OUT_PTR_HPP
+#define ZTD_OUT_PTR_BATCH_OUT_PTR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
+#include <ztd/out_ptr/detail/batch_out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/integer_sequence.hpp>
+#include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+namespace ztd { namespace out_ptr {
+
+	template <typename Range, typename Pointer, typename... Args>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ batch_out_ptr_t
+	: public op_detail::base_out_ptr_impl<Range, Pointer, batch_out_ptr_traits<Range, Pointer>, std::tuple<std::size_t, Args...>, ztd::out_ptr::op_detail::make_index_sequence<1 + sizeof...(Args)>> {
+	private:
+		using traits_t = batch_out_ptr_traits<Range, Pointer>;
+		using list_t   = ztd::out_ptr::op_detail::make_index_sequence<1 + sizeof...(Args)>;
+		using core_t   = op_detail::base_out_ptr_impl<Range, Pointer, traits_t, std::tuple<std::size_t, Args...>, list_t>;
+
+	public:
+		// the scratch buffer is allocated here, rather than in the (noexcept) base,
+		// so an allocation failure is reported before the C function is ever called
+		batch_out_ptr_t(Range& r, std::size_t count, Args... args)
+		: core_t(r, std::forward_as_tuple(count, std::forward<Args>(args)...), traits_t::construct(r, count, args...)) {
+		}
+	};
+
+	namespace op_detail {
+		template <typename Pointer, typename Range, typename... Args>
+		batch_out_ptr_t<Range, Pointer, Args...> batch_out_ptr_tagged(std::false_type, Range& r, std::size_t count, Args&&... args) {
+			using P = batch_out_ptr_t<Range, Pointer, Args...>;
+			return P(r, count, std::forward<Args>(args)...);
+		}
+
+		template <typename, typename Range, typename... Args>
+		batch_out_ptr_t<Range, pointer_of_t<range_value_t<Range>>, Args...> batch_out_ptr_tagged(std::true_type, Range& r, std::size_t count, Args&&... args) {
+			using Pointer = pointer_of_t<range_value_t<Range>>;
+			using P	    = batch_out_ptr_t<Range, Pointer, Args...>;
+			return P(r, count, std::forward<Args>(args)...);
+		}
+
+	} // namespace op_detail
+
+	template <typename Pointer = op_detail::marker, typename Range, typename... Args>
+	auto batch_out_ptr(Range& r, std::size_t count, Args&&... args)
+		-> decltype(op_detail::batch_out_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), r, count, std::forward<Args>(args)...)) {
+		return op_detail::batch_out_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), r, count, std::forward<Args>(args)...);
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_COMMITS_NULL_AS_EMPTY_HPP
+#define ZTD_OUT_PTR_COMMITS_NULL_AS_EMPTY_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/customization_forward.hpp>
+
+#include <memory>
+#include <type_traits>
+
+namespace ztd { namespace out_ptr {
+
+	// A smart pointer which, when the C function outputs null, is reset to empty
+	// (.reset() or Smart()) rather than given the null pointer and the arguments.
+	// shared_ptr would otherwise allocate a control block and copy the deleter,
+	// just to own nothing. Specialize this for other types with the same cost.
+	template <typename Smart>
+	struct commits_null_as_empty : std::false_type {};
+
+	template <typename T>
+	struct commits_null_as_empty<std::shared_ptr<T>> : std::true_type {};
+
+	template <typename T>
+	struct commits_null_as_empty<boost::shared_ptr<T>> : std::true_type {};
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,191 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DEFERRED_OUT_PTR_HPP
+#define ZTD_OUT_PTR_DEFERRED_OUT_PTR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/detail/simple_out_ptr.hpp>
+#include <ztd/out_ptr/detail/invoke_access.hpp>
+#include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/detail/voidpp_op.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+#include <coroutine>
+#endif
+
+namespace ztd { namespace out_ptr {
+
+	// an out_ptr for C functions which take the output when the work is submitted,
+	// and write it later from another thread or a completion callback: the output
+	// lives inside this object, which therefore can neither be copied nor moved,
+	// and is committed when complete() is called rather than at the end of the full expression.
+	// The simple implementation is always used: the clever ones write into the smart pointer
+	// itself, which would then be empty, and written from another thread, until completion
+	template <typename Smart, typename Pointer = pointer_of_t<Smart>, typename... Args>
+	class deferred_out_ptr_t : public op_detail::voidpp_op<deferred_out_ptr_t<Smart, Pointer, Args...>, Pointer> {
+	private:
+		using adaptor_t = op_detail::simple_out_ptr_t<Smart, Pointer, Args...>;
+
+		enum : int {
+			pending  = 0,
+			awaited  = 1,
+			finished = 2
+		};
+
+		// signals completion even if the commit throws, so a waiter is never left hanging
+		struct finisher {
+			deferred_out_ptr_t& self;
+
+			~finisher() {
+				self.finish();
+			}
+		};
+
+		adaptor_t m_adaptor;
+		Smart* m_smart_ptr;
+		std::atomic<int> m_state;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_finished;
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+		std::coroutine_handle<> m_awaiter;
+#endif
+
+		// nothing in this object is touched once the lock is released:
+		// whoever sees it finished may destroy it right away
+		void finish() noexcept {
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+			std::coroutine_handle<> awaiter;
+#endif
+			{
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				int previous = this->m_state.exchange(finished, std::memory_order_acq_rel);
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+				if (previous == awaited) {
+					awaiter = this->m_awaiter;
+				}
+#else
+				(void)previous;
+#endif
+				this->m_finished.notify_all();
+			}
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+			if (awaiter) {
+				awaiter.resume();
+			}
+#endif
+		}
+
+	public:
+		deferred_out_ptr_t(Smart& s, Args... args)
+		: m_adaptor(s, std::forward<Args>(args)...), m_smart_ptr(std::addressof(s)), m_state(pending), m_mutex(), m_finished()
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+		, m_awaiter()
+#endif
+		{
+		}
+
+		deferred_out_ptr_t(const deferred_out_ptr_t&)			= delete;
+		deferred_out_ptr_t& operator=(const deferred_out_ptr_t&) = delete;
+
+		// the address handed to the C function: it stays valid until this object is destroyed
+		Pointer* get() const noexcept {
+			return static_cast<Pointer*>(this->m_adaptor);
+		}
+
+		operator Pointer*() const noexcept {
+			return this->get();
+		}
+
+		// commits whatever the C function wrote into the smart pointer,
+		// then wakes anyone waiting; called once, from any thread
+		void complete() {
+			finisher signal { *this };
+			op_detail::invoke_access::commit(this->m_adaptor);
+		}
+
+		// the operation failed or was cancelled: the smart pointer is left as it was,
+		// without a reset or deleter call, and anyone waiting is woken
+		void abandon() noexcept {
+			op_detail::invoke_access::abandon(this->m_adaptor);
+			this->finish();
+		}
+
+		bool ready() const {
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			return this->m_state.load(std::memory_order_acquire) == finished;
+		}
+
+		Smart& wait() {
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_finished.wait(lock, [this]() { return this->m_state.load(std::memory_order_acquire) == finished; });
+			return *this->m_smart_ptr;
+		}
+
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+		// co_await resumes with the committed smart pointer, on the thread which completed it;
+		// only one coroutine may wait on it at a time
+		bool await_ready() const {
+			return this->ready();
+		}
+
+		bool await_suspend(std::coroutine_handle<> awaiter) noexcept {
+			this->m_awaiter = awaiter;
+			int expected	= pending;
+			// if it finished in the meantime, keep going without suspending
+			return this->m_state.compare_exchange_strong(expected, awaited, std::memory_order_acq_rel, std::memory_order_acquire);
+		}
+
+		Smart& await_resume() const noexcept {
+			return *this->m_smart_ptr;
+		}
+#endif
+
+		// must only be destroyed once completed or abandoned: the C function
+		// may otherwise still write into it. If neither happened, the output
+		// is not from a finished call and is dropped rather than committed
+		~deferred_out_ptr_t() {
+			if (this->m_state.load(std::memory_order_acquire) != finished) {
+				op_detail::invoke_access::abandon(this->m_adaptor);
+			}
+		}
+	};
+
+#if ZTD_OUT_PTR_HAS_GUARANTEED_COPY_ELISION_I_
+	namespace op_detail {
+		template <typename Pointer, typename Smart>
+		using deferred_pointer_t = typename std::conditional<std::is_same<Pointer, marker>::value, pointer_of_t<Smart>, Pointer>::type;
+	} // namespace op_detail
+
+	// arguments are kept by value: they must outlive the call, until it completes
+	template <typename Pointer = op_detail::marker, typename Smart, typename... Args>
+	deferred_out_ptr_t<Smart, op_detail::deferred_pointer_t<Pointer, Smart>, typename std::decay<Args>::type...> deferred_out_ptr(Smart& s, Args&&... args) {
+		return deferred_out_ptr_t<Smart, op_detail::deferred_pointer_t<Pointer, Smart>, typename std::decay<Args>::type...>(s, std::forward<Args>(args)...);
+	}
+#endif
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,99 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_ARRAY_OUT_PTR_TRAITS_HPP
+#define ZTD_OUT_PTR_DETAIL_ARRAY_OUT_PTR_TRAITS_HPP
+
+#include <ztd/out_ptr/necessary_arity.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ztd {
+namespace out_ptr {
+
+	namespace op_detail {
+
+		template <typename Array>
+		struct array_extent;
+
+		template <typename T, std::size_t N>
+		struct array_extent<T[N]> {
+			using value_type					   = T;
+			static constexpr const std::size_t size = N;
+		};
+
+		template <typename T, std::size_t N>
+		struct array_extent<std::array<T, N>> {
+			using value_type					   = T;
+			static constexpr const std::size_t size = N;
+		};
+
+		template <typename Array>
+		using array_value_t = typename array_extent<Array>::value_type;
+
+	} // namespace op_detail
+
+	template <typename Array, typename Pointer>
+	class array_out_ptr_traits {
+	private:
+		template <typename T>
+		friend struct op_detail::has_unspecialized_marker;
+		using OUT_PTR_DETAIL_UNSPECIALIZED_MARKER_ = int;
+		using smart_t						   = op_detail::array_value_t<Array>;
+		using source_pointer				   = pointer_of_or_t<smart_t, Pointer>;
+
+	public:
+		// a fixed number of outputs: the scratch space lives on the stack
+		using pointer = std::array<Pointer, op_detail::array_extent<Array>::size>;
+
+		template <typename... Args>
+		static pointer construct(Array& a, Args&&...) noexcept {
+			static_assert(sizeof...(Args) >= necessary_arity<smart_t, Args...>::value,
+				"array_out_ptr requires certain arguments to be passed in for use with this element type "
+				"(e.g. shared_ptr<T> must pass a deleter in so when reset is called the "
+				"deleter can be properly initialized, otherwise the deleter will be "
+				"defaulted by the shared_ptr<T>::reset() call!)");
+			pointer p;
+			for (std::size_t i = 0; i < p.size(); ++i) {
+				p[i] = op_detail::handle_null<Pointer>(a[i]);
+			}
+			return p;
+		}
+
+		static Pointer* get(Array&, pointer& p) noexcept {
+			return p.data();
+		}
+
+		template <typename... Args>
+		static void reset(Array& a, pointer& p, Args&&... args) noexcept {
+			for (std::size_t i = 0; i < p.size(); ++i) {
+				// arguments (e.g. deleters) are copied into every element,
+				// so they cannot be forwarded / moved from here
+				op_detail::commit_or_create(a[i], static_cast<source_pointer>(std::move(p[i])), args...);
+			}
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
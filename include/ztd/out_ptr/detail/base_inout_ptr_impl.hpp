@@ -35,10 +35,46 @@ namespace op_detail {
 	private:
 		using base_t = base_out_ptr_impl<Smart, Pointer, inout_ptr_traits<Smart, Pointer>, Args, List>;
 
+		friend struct invoke_access;
+
+		static Pointer current(std::true_type, Smart& s) noexcept {
+			return static_cast<Pointer>(s);
+		}
+
+		static Pointer current(std::false_type, Smart& s) noexcept {
+			return static_cast<Pointer>(s.get());
+		}
+
+		bool left_in_place(std::true_type) const noexcept {
+			return inout_ptr_traits<Smart, Pointer>::unchanged(this->m_target_ptr);
+		}
+
+		bool left_in_place(std::false_type) const noexcept {
+			// through the traits, whose storage may hold more than the output itself
+			const Pointer* output = static_cast<Pointer*>(*this);
+			return *output == current(std::is_pointer<Smart>(), *this->m_smart_ptr);
+		}
+
+		// the call failed: the input is still owned only if the C function left it in place,
+		// anything else it wrote is adopted as usual (the smart pointer itself is not touched
+		// until the commit, so it still holds the input)
+		void abandon() noexcept(noexcept(std::declval<base_inout_ptr_impl&>().commit())) {
+			if (this->m_smart_ptr == nullptr) {
+				return;
+			}
+			if (left_in_place(std::integral_constant<bool, has_traits_unchanged_call<inout_ptr_traits<Smart, Pointer>>::value>())) {
+				base_t::abandon();
+			}
+			else {
+				base_t::commit();
+			}
+		}
+
 	public:
-		base_inout_ptr_impl(Smart& ptr, Args&& args) noexcept
+		base_inout_ptr_impl(Smart& ptr, Args&& args) noexcept(std::is_nothrow_constructible<base_t, Smart&, Args&&>::value)
 		: base_t(ptr, std::move(args)) {
-			static_assert(is_releasable<Smart>::value || std::is_pointer<Smart>::value, "You cannot use an inout pointer with something that cannot release() its pointer!");
+			static_assert(is_releasable<Smart>::value || std::is_pointer<Smart>::value || !has_unspecialized_marker<inout_ptr_traits<Smart, Pointer>>::value,
+				"You cannot use an inout pointer with something that cannot release() its pointer, unless inout_ptr_traits is specialized for it!");
 		}
 
 		base_inout_ptr_impl(base_inout_ptr_impl&& right) noexcept
@@ -47,6 +83,7 @@ namespace op_detail {
 
 		base_inout_ptr_impl& operator=(base_inout_ptr_impl&& right) noexcept {
 			static_cast<base_t&>(*this) = std::move(right);
+			return *this;
 		}
 	};
 
@@ -50,36 +50,85 @@ namespace op_detail {
 
 
 
+			// empty, trivially copyable arguments (e.g. a stateless deleter passed as an lvalue)
+			// are kept by value, where the empty base optimization makes them free,
+			// instead of as a reference which costs a word and an indirection
+			template <typename Arg>
+			using compressed_arg_t = typename std::conditional<std::is_empty<typename std::decay<Arg>::type>::value
+					&& std::is_trivially_copyable<typename std::decay<Arg>::type>::value,
+				typename std::decay<Arg>::type, Arg>::type;
+
+			template <typename Args>
+			struct compressed_args;
+
+			template <typename... Args>
+			struct compressed_args<std::tuple<Args...>> {
+				using type = std::tuple<compressed_arg_t<Args>...>;
+			};
+
+			// the size the adaptors are held to: the smart pointer's address and one more value,
+			// small enough to be kept in registers once the adaptor is inlined
+			template <typename First, typename Second>
+			struct two_words {
+				First first;
+				Second second;
+			};
+
+			// lets ztd::out_ptr::invoke and deferred_out_ptr commit an adaptor early, or give up on it,
+			// once they know whether the C function succeeded
+			struct invoke_access;
+
 			template <typename Smart, typename Pointer, typename Traits, typename Args, typename List>
-			class ZTD_OUT_PTR_TRIVIAL_ABI_I_ base_out_ptr_impl;
+			class ZTD_OUT_PTR_TRIVIAL_ABI_I_ ZTD_OUT_PTR_EMPTY_BASES_I_ base_out_ptr_impl;
 
 			template <typename Smart, typename Pointer, typename Traits, typename Base, std::size_t... Indices>
-			class ZTD_OUT_PTR_TRIVIAL_ABI_I_ base_out_ptr_impl<Smart, Pointer, Traits, Base, ztd::out_ptr::op_detail::index_sequence<Indices...>>
-			: public voidpp_op<base_out_ptr_impl<Smart, Pointer, Traits, Base, ztd::out_ptr::op_detail::index_sequence<Indices...>>, Pointer>, protected Base {
+			class ZTD_OUT_PTR_TRIVIAL_ABI_I_ ZTD_OUT_PTR_EMPTY_BASES_I_ base_out_ptr_impl<Smart, Pointer, Traits, Base, ztd::out_ptr::op_detail::index_sequence<Indices...>>
+			: public voidpp_op<base_out_ptr_impl<Smart, Pointer, Traits, Base, ztd::out_ptr::op_detail::index_sequence<Indices...>>, Pointer>, protected compressed_args<Base>::type {
 			protected:
 				using traits_t = Traits;
 				using storage	= pointer_of_or_t<traits_t, Pointer>;
+				using args_t	= typename compressed_args<Base>::type;
 				Smart* m_smart_ptr;
 				storage m_target_ptr;
 
 				ZTD_OUT_PTR_SAFETY_ASSERTION();
 
 				base_out_ptr_impl(Smart& ptr, Base&& args, storage initial) noexcept
-				: Base(std::move(args)), m_smart_ptr(std::addressof(ptr)), m_target_ptr(initial) {
+				: args_t(std::move(args)), m_smart_ptr(std::addressof(ptr)), m_target_ptr(std::move(initial)) {
 					ZTD_OUT_PTR_SAFETY_ASSERTION();
 				}
 
+				friend struct invoke_access;
+
+				void commit() noexcept(noexcept(traits_t::reset(std::declval<Smart&>(), std::declval<storage&>(), std::get<Indices>(std::move(std::declval<args_t&>()))...))) {
+					if (this->m_smart_ptr) {
+						// disarmed first: a throwing reset must not be run again by the destructor
+						Smart& smart_ptr = *this->m_smart_ptr;
+						this->m_smart_ptr = nullptr;
+						args_t&& args	  = std::move(static_cast<args_t&>(*this));
+						(void)args; // unused if "Indices" is empty
+						traits_t::reset(smart_ptr, this->m_target_ptr, std::get<Indices>(std::move(args))...);
+					}
+				}
+
+				// the call failed: the smart pointer was never touched, so it keeps what it had
+				void abandon() noexcept {
+					this->m_smart_ptr = nullptr;
+				}
+
 			public:
-				base_out_ptr_impl(Smart& ptr, Base&& args) noexcept
-				: Base(std::move(args)), m_smart_ptr(std::addressof(ptr)), m_target_ptr(traits_t::construct(ptr, std::get<Indices>(static_cast<Base&>(*this))...)) {
+				// only as noexcept as the traits: some record the output somewhere before the call,
+				// so that committing it afterwards cannot fail
+				base_out_ptr_impl(Smart& ptr, Base&& args) noexcept(noexcept(traits_t::construct(ptr, std::get<Indices>(std::declval<args_t&>())...)))
+				: args_t(std::move(args)), m_smart_ptr(std::addressof(ptr)), m_target_ptr(traits_t::construct(ptr, std::get<Indices>(static_cast<args_t&>(*this))...)) {
 				}
 
 				base_out_ptr_impl(base_out_ptr_impl&& right) noexcept
-				: Base(std::move(right)), m_smart_ptr(right.m_smart_ptr), m_target_ptr(std::move(right.m_target_ptr)) {
+				: args_t(std::move(right)), m_smart_ptr(right.m_smart_ptr), m_target_ptr(std::move(right.m_target_ptr)) {
 					right.m_smart_ptr = nullptr;
 				}
 				base_out_ptr_impl& operator=(base_out_ptr_impl&& right) noexcept {
-					static_cast<Base&>(*this) = std::move(right);
+					static_cast<args_t&>(*this) = std::move(right);
 					this->m_smart_ptr		 = std::move(right.m_smart_ptr);
 					this->m_target_ptr		 = std::move(right.m_target_ptr);
 					right.m_smart_ptr		 = nullptr;
@@ -92,13 +141,11 @@ namespace op_detail {
 					return call_traits_get<traits_t>(has_get_call(), *const_cast<Smart*>(this->m_smart_ptr), const_cast<storage&>(this->m_target_ptr));
 				}
 
-				~base_out_ptr_impl() noexcept(noexcept(traits_t::reset(std::declval<Smart&>(), std::declval<storage&>(), std::get<Indices>(std::move(std::declval<Base&>()))...))) {
+				~base_out_ptr_impl() noexcept(noexcept(traits_t::reset(std::declval<Smart&>(), std::declval<storage&>(), std::get<Indices>(std::move(std::declval<args_t&>()))...))) {
 					ZTD_OUT_PTR_SAFETY_ASSERTION();
-					if (this->m_smart_ptr) {
-						Base&& args = std::move(static_cast<Base&>(*this));
-						(void)args; // unused if "Indices" is empty
-						traits_t::reset(*this->m_smart_ptr, this->m_target_ptr, std::get<Indices>(std::move(args))...);
-					}
+					static_assert(!std::is_empty<args_t>::value || sizeof(base_out_ptr_impl) == sizeof(two_words<Smart*, storage>),
+						"stateless arguments must not make the adaptor larger than the smart pointer's address and the output");
+					this->commit();
 				}
 			};
 
@@ -0,0 +1,180 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_BATCH_OUT_PTR_TRAITS_HPP
+#define ZTD_OUT_PTR_DETAIL_BATCH_OUT_PTR_TRAITS_HPP
+
+#include <ztd/out_ptr/necessary_arity.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ztd {
+namespace out_ptr {
+
+	namespace op_detail {
+
+		template <typename Range>
+		struct range_value {
+			using type = typename std::remove_cv<typename std::remove_reference<decltype(*std::begin(std::declval<Range&>()))>::type>::type;
+		};
+
+		template <typename Range>
+		using range_value_t = typename range_value<Range>::type;
+
+		template <typename T, typename = void>
+		struct is_resizable : std::false_type {
+		};
+
+		template <typename T>
+		struct is_resizable<T, op_detail::void_t<decltype(std::declval<T&>().resize(std::declval<std::size_t>()))>> : std::true_type {
+		};
+
+		template <typename Range>
+		void batch_resize(std::true_type, Range& r, std::size_t count) {
+			r.resize(count);
+		}
+
+		template <typename Range>
+		void batch_resize(std::false_type, Range&, std::size_t) noexcept {
+			// fixed-size ranges must already have enough room for all of the outputs
+		}
+
+		// how many outputs the scratch buffer holds without going to the heap: all of them for
+		// a small fixed-size range, and the most common batch sizes otherwise
+		constexpr const std::size_t batch_inline_default = 16;
+		constexpr const std::size_t batch_inline_max	 = 64;
+
+		template <typename Range>
+		struct batch_inline_capacity : std::integral_constant<std::size_t, batch_inline_default> {};
+
+		template <typename T, std::size_t N>
+		struct batch_inline_capacity<T[N]> : std::integral_constant<std::size_t, (N < batch_inline_max ? N : batch_inline_max)> {};
+
+		template <typename T, std::size_t N>
+		struct batch_inline_capacity<std::array<T, N>> : std::integral_constant<std::size_t, (N < batch_inline_max ? N : batch_inline_max)> {};
+
+		// one contiguous scratch buffer handed to the C function: kept inline for up to
+		// Inline outputs, and only allocated for bigger batches
+		template <typename Pointer, std::size_t Inline>
+		class batch_scratch {
+		private:
+			Pointer m_inline[Inline == 0 ? 1 : Inline];
+			std::unique_ptr<Pointer[]> m_heap;
+			std::size_t m_size;
+
+		public:
+			// the inline outputs are left uninitialized: only the first m_size are ever read
+			batch_scratch() noexcept : m_heap(), m_size(0) {
+			}
+
+			batch_scratch(std::size_t count, const Pointer& value)
+			: m_heap(count > Inline ? new Pointer[count] : nullptr), m_size(count) {
+				std::fill(this->data(), this->data() + count, value);
+			}
+
+			batch_scratch(batch_scratch&& right) noexcept
+			: m_heap(std::move(right.m_heap)), m_size(right.m_size) {
+				if (!this->m_heap) {
+					std::move(right.m_inline, right.m_inline + this->m_size, this->m_inline);
+				}
+				right.m_size = 0;
+			}
+
+			batch_scratch& operator=(batch_scratch&& right) noexcept {
+				this->m_heap = std::move(right.m_heap);
+				this->m_size = right.m_size;
+				if (!this->m_heap) {
+					std::move(right.m_inline, right.m_inline + this->m_size, this->m_inline);
+				}
+				right.m_size = 0;
+				return *this;
+			}
+
+			Pointer* data() noexcept {
+				return this->m_heap ? this->m_heap.get() : this->m_inline;
+			}
+
+			std::size_t size() const noexcept {
+				return this->m_size;
+			}
+
+			Pointer& operator[](std::size_t i) noexcept {
+				return this->data()[i];
+			}
+		};
+
+	} // namespace op_detail
+
+	template <typename Range, typename Pointer>
+	class batch_out_ptr_traits {
+	private:
+		using smart_t		    = op_detail::range_value_t<Range>;
+		using source_pointer = pointer_of_or_t<smart_t, Pointer>;
+
+	public:
+		// one contiguous scratch buffer handed to the C function,
+		// rather than N separate temporaries
+		using pointer = op_detail::batch_scratch<Pointer, op_detail::batch_inline_capacity<typename std::remove_cv<Range>::type>::value>;
+
+		template <typename... Args>
+		static pointer construct(Range& r, std::size_t count, Args&&...) {
+			static_assert(sizeof...(Args) >= necessary_arity<smart_t, Args...>::value,
+				"batch_out_ptr requires certain arguments to be passed in for use with this element type "
+				"(e.g. shared_ptr<T> must pass a deleter in so when reset is called the "
+				"deleter can be properly initialized, otherwise the deleter will be "
+				"defaulted by the shared_ptr<T>::reset() call!)");
+			// size the destination before the C call is made, so that
+			// committing the results afterwards cannot fail and leak
+			op_detail::batch_resize(op_detail::is_resizable<Range>(), r, count);
+			if (static_cast<std::size_t>(std::distance(std::begin(r), std::end(r))) < count) {
+				throw std::length_error("batch_out_ptr: the range cannot hold that many outputs, and cannot be resized");
+			}
+			if (count == 0) {
+				return pointer();
+			}
+			return pointer(count, op_detail::handle_null<Pointer>(*std::begin(r)));
+		}
+
+		static Pointer* get(Range&, pointer& p) noexcept {
+			return p.data();
+		}
+
+		template <typename... Args>
+		static void reset(Range& r, pointer& p, std::size_t count, Args&&... args) noexcept {
+			auto it = std::begin(r);
+			for (std::size_t i = 0; i < count; ++i, ++it) {
+				// arguments (e.g. deleters) are copied into every element,
+				// so they cannot be forwarded / moved from here
+				op_detail::commit_or_create(*it, static_cast<source_pointer>(std::move(p[i])), args...);
+			}
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
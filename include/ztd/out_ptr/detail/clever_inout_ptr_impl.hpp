@@ -24,6 +24,9 @@
 #include <ztd/out_ptr/detail/base_inout_ptr_impl.hpp>
 #include <ztd/out_ptr/detail/is_specialization_of.hpp>
 #include <ztd/out_ptr/detail/voidpp_op.hpp>
+#include <ztd/out_ptr/detail/is_aliasable_pointer.hpp>
+#include <ztd/out_ptr/detail/unique_layout.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
 #include <ztd/out_ptr/pointer_of.hpp>
 #include <ztd/out_ptr/detail/integer_sequence.hpp>
 
@@ -44,6 +47,11 @@ namespace ztd {
 namespace out_ptr {
 namespace op_detail {
 
+	// boost::movelib::unique_ptr stores reference and function deleters differently from object deleters
+	template <typename Smart, typename D, typename Source>
+	using movelib_inout_unique_layout = unique_layout<Smart, D, Source,
+		(std::is_reference<D>::value || std::is_function<D>::value) == (ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ != 0)>;
+
 	template <typename Smart, typename T, typename D, typename Pointer>
 	struct ZTD_OUT_PTR_TRIVIAL_ABI_I_ inout_unique_fast : voidpp_op<inout_unique_fast<Smart, T, D, Pointer>, Pointer> {
 	public:
@@ -52,6 +60,9 @@ namespace op_detail {
 	private:
 		using can_aliasing_optimization = std::integral_constant<bool,
 			sizeof(Smart) <= sizeof(Pointer) && sizeof(Smart) <= sizeof(source_pointer)>;
+		using layout_t = typename std::conditional<is_specialization_of<Smart, boost::movelib::unique_ptr>::value,
+			movelib_inout_unique_layout<Smart, D, source_pointer>,
+			unique_layout<Smart, D, source_pointer, std_unique_pointer_first<D>::value>>::type;
 
 		Pointer* m_target_ptr;
 
@@ -63,52 +74,8 @@ namespace op_detail {
 #endif // Clever Sanity Checks
 		}
 
-		inout_unique_fast(std::false_type, Smart& ptr) noexcept {
-			// analysis necessary
-			void* target;
-			if (is_specialization_of<Smart, boost::movelib::unique_ptr>::value) {
-				// boost::movelib::unique_ptr
-#if ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_
-				if (std::is_reference<D>::value || std::is_function<D>::value) {
-					// implementation has Pointer as first member: alias directly
-					target = static_cast<void*>(std::addressof(ptr));
-				}
-				else {
-					// implementation has Pointer as second member: shift, align, alias
-					constexpr const std::size_t memory_start = sizeof(D) + (sizeof(D) % alignof(D));
-					std::size_t max_space				 = sizeof(Smart) - memory_start;
-					void* source						 = static_cast<void*>(static_cast<char*>(static_cast<void*>(std::addressof(ptr))) + memory_start);
-					target							 = std::align(alignof(source_pointer), sizeof(source_pointer), source, max_space);
-				}
-#else
-				if (std::is_reference<D>::value || std::is_function<D>::value) {
-					// implementation has Pointer as second member: shift, align, alias
-					constexpr const std::size_t memory_start = sizeof(D) + (sizeof(D) % alignof(D));
-					std::size_t max_space				 = sizeof(Smart) - memory_start;
-					void* source						 = static_cast<void*>(static_cast<char*>(static_cast<void*>(std::addressof(ptr))) + memory_start);
-					target							 = std::align(alignof(source_pointer), sizeof(source_pointer), source, max_space);
-				}
-				else {
-					// implementation has Pointer as first member: alias directly
-					target = static_cast<void*>(std::addressof(ptr));
-				}
-#endif
-			}
-			else {
-				// std::unique_ptr
-#if ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_
-				// implementation has Pointer as first member: alias directly
-				target = static_cast<void*>(std::addressof(ptr));
-#else
-				// implementation has Pointer as second member: shift, align, alias
-				constexpr const std::size_t memory_start = sizeof(D) + (sizeof(D) % alignof(D));
-				std::size_t max_space				 = sizeof(Smart) - memory_start;
-				void* source						 = static_cast<void*>(static_cast<char*>(static_cast<void*>(std::addressof(ptr))) + memory_start);
-				target							 = std::align(alignof(source_pointer), sizeof(source_pointer), source, max_space);
-#endif
-			}
-			// get direct Pointer
-			this->m_target_ptr = static_cast<Pointer*>(target);
+		inout_unique_fast(std::false_type, Smart& ptr) noexcept
+		: m_target_ptr(static_cast<Pointer*>(layout_t::pointer_address(ptr))) {
 #if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
 			assert(*this->m_target_ptr == static_cast<Pointer>(ptr.get()) && "clever UB-based optimization did not properly retrieve the pointer value, consider turning it off for your platform");
 #endif // Clever Sanity Checks
@@ -126,6 +93,27 @@ namespace op_detail {
 		}
 	};
 
+	// the C function consumes the old value and writes the new one in its place
+	template <typename Smart, typename Pointer>
+	struct ZTD_OUT_PTR_TRIVIAL_ABI_I_ inout_integral_fast : voidpp_op<inout_integral_fast<Smart, Pointer>, Pointer> {
+	private:
+		Pointer* m_target_ptr;
+
+	public:
+		inout_integral_fast(Smart& ptr, std::tuple<>&&) noexcept
+		: m_target_ptr(static_cast<Pointer*>(static_cast<void*>(std::addressof(ptr)))) {
+#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
+			assert(*this->m_target_ptr == ptr.get() && "clever UB-based optimization did not properly retrieve the handle value");
+#endif // Clever Sanity Checks
+		}
+		inout_integral_fast(inout_integral_fast&& right) noexcept			= default;
+		inout_integral_fast& operator=(inout_integral_fast&& right) noexcept = default;
+
+		operator Pointer*() const noexcept {
+			return const_cast<Pointer*>(this->m_target_ptr);
+		}
+	};
+
 	template <typename Smart, typename Pointer, typename Args, typename List, typename = void>
 	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_inout_ptr_impl : public base_inout_ptr_impl<Smart, Pointer, Args, List> {
 	private:
@@ -139,10 +127,10 @@ namespace op_detail {
 	template <typename T, typename D, typename Pointer>
 	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_inout_ptr_impl<std::unique_ptr<T, D>, Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>,
 		typename std::enable_if<
-			std::is_same<pointer_of_t<std::unique_ptr<T, D>>, Pointer>::value
-			|| op_detail::has_unspecialized_marker<out_ptr_traits<std::unique_ptr<T, D>, Pointer>>::value
-			|| std::is_base_of<pointer_of_t<std::unique_ptr<T, D>>, Pointer>::value
-			|| !std::is_convertible<pointer_of_t<std::unique_ptr<T, D>>, Pointer>::value>::type>
+			op_detail::has_unspecialized_marker<out_ptr_traits<std::unique_ptr<T, D>, Pointer>>::value
+			&& op_detail::has_unspecialized_marker<inout_ptr_traits<std::unique_ptr<T, D>, Pointer>>::value
+			&& op_detail::is_aliasable_pointer<pointer_of_t<std::unique_ptr<T, D>>, Pointer>::value
+			&& std_unique_layout<T, D>::matches>::type>
 	: public inout_unique_fast<std::unique_ptr<T, D>, T, D, Pointer> {
 	private:
 		using base_t = inout_unique_fast<std::unique_ptr<T, D>, T, D, Pointer>;
@@ -154,10 +142,10 @@ namespace op_detail {
 	template <typename T, typename D, typename Pointer>
 	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_inout_ptr_impl<boost::movelib::unique_ptr<T, D>, Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>,
 		typename std::enable_if<
-			std::is_same<pointer_of_t<boost::movelib::unique_ptr<T, D>>, Pointer>::value
-			|| op_detail::has_unspecialized_marker<out_ptr_traits<boost::movelib::unique_ptr<T, D>, Pointer>>::value
-			|| std::is_base_of<pointer_of_t<boost::movelib::unique_ptr<T, D>>, Pointer>::value
-			|| !std::is_convertible<pointer_of_t<boost::movelib::unique_ptr<T, D>>, Pointer>::value>::type>
+			op_detail::has_unspecialized_marker<out_ptr_traits<boost::movelib::unique_ptr<T, D>, Pointer>>::value
+			&& op_detail::has_unspecialized_marker<inout_ptr_traits<boost::movelib::unique_ptr<T, D>, Pointer>>::value
+			&& op_detail::is_aliasable_pointer<pointer_of_t<boost::movelib::unique_ptr<T, D>>, Pointer>::value
+			&& movelib_inout_unique_layout<boost::movelib::unique_ptr<T, D>, D, pointer_of_t<boost::movelib::unique_ptr<T, D>>>::matches>::type>
 	: public inout_unique_fast<boost::movelib::unique_ptr<T, D>, T, D, Pointer> {
 	private:
 		using base_t = inout_unique_fast<boost::movelib::unique_ptr<T, D>, T, D, Pointer>;
@@ -166,6 +154,19 @@ namespace op_detail {
 		using base_t::base_t;
 	};
 
+	template <typename Smart, typename Pointer>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_inout_ptr_impl<Smart, Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>,
+		typename std::enable_if<is_integral_handle<Smart, Pointer>::value
+			&& op_detail::has_unspecialized_marker<out_ptr_traits<Smart, Pointer>>::value
+			&& op_detail::has_unspecialized_marker<inout_ptr_traits<Smart, Pointer>>::value>::type>
+	: public inout_integral_fast<Smart, Pointer> {
+	private:
+		using base_t = inout_integral_fast<Smart, Pointer>;
+
+	public:
+		using base_t::base_t;
+	};
+
 }}} // namespace ztd::out_ptr::op_detail
 
 #if defined(_MSC_VER)
@@ -49,6 +49,20 @@ namespace op_detail {
 		}
 	};
 
+	// aliases into the unique_ptr's storage like clever_out_ptr_t, but nulls it before
+	// the call: safe for C functions that leave the output untouched on failure
+	template <typename Smart, typename Pointer, typename... Args>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ prenull_out_ptr_t : public clever_out_ptr_impl<Smart, Pointer, std::tuple<Args...>, ztd::out_ptr::op_detail::make_index_sequence<std::tuple_size<std::tuple<Args...>>::value>, true> {
+	private:
+		using list_t = ztd::out_ptr::op_detail::make_index_sequence<std::tuple_size<std::tuple<Args...>>::value>;
+		using core_t = clever_out_ptr_impl<Smart, Pointer, std::tuple<Args...>, list_t, true>;
+
+	public:
+		prenull_out_ptr_t(Smart& s, Args... args) noexcept
+		: core_t(s, std::forward_as_tuple(std::forward<Args>(args)...)) {
+		}
+	};
+
 	template <typename Pointer, typename Smart, typename... Args>
 	clever_out_ptr_t<Smart, Pointer, Args...> clever_out_ptr_tagged(std::false_type, Smart& s, Args&&... args) noexcept(::std::is_nothrow_constructible<clever_out_ptr_t<Smart, Pointer, Args...>, Smart&, Args...>::value) {
 		using P = clever_out_ptr_t<Smart, Pointer, Args...>;
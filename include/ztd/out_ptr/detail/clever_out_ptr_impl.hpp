@@ -24,7 +24,11 @@
 #include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
 #include <ztd/out_ptr/detail/customization_forward.hpp>
 #include <ztd/out_ptr/detail/voidpp_op.hpp>
+#include <ztd/out_ptr/detail/is_aliasable_pointer.hpp>
 #include <ztd/out_ptr/detail/integer_sequence.hpp>
+#include <ztd/out_ptr/detail/unique_layout.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
+#include <ztd/out_ptr/is_intrusive_handle.hpp>
 
 #include <memory>
 #include <tuple>
@@ -41,90 +45,236 @@ namespace ztd {
 namespace out_ptr {
 namespace op_detail {
 
-	template <typename Smart, typename T, typename D, typename Pointer>
-	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ out_unique_fast : voidpp_op<out_unique_fast<Smart, T, D, Pointer>, Pointer> {
+	template <typename Smart, typename T, typename D, typename Pointer, bool PreNull = false>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ out_unique_fast : public voidpp_op<out_unique_fast<Smart, T, D, Pointer, PreNull>, Pointer> {
 	protected:
 		using source_pointer = pointer_of_or_t<Smart, Pointer>;
 
 	private:
 		using can_aliasing_optimization = std::integral_constant<bool,
 			sizeof(Smart) <= sizeof(Pointer) && sizeof(Smart) <= sizeof(source_pointer)>;
+		using layout_t = typename std::conditional<is_specialization_of<Smart, boost::movelib::unique_ptr>::value,
+			unique_layout<Smart, D, source_pointer, ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ != 0>,
+			unique_layout<Smart, D, source_pointer, std_unique_pointer_first<D>::value>>::type;
+		// the target is a fixed offset into the smart pointer: it is recomputed
+		// rather than stored, keeping the adaptor at two words
 		Smart* m_smart_ptr;
 		source_pointer m_old_ptr;
-		Pointer* m_target_ptr;
 
-		out_unique_fast(std::true_type, Smart& ptr) noexcept
-		: m_smart_ptr(std::addressof(ptr)), m_old_ptr(ptr.get()), m_target_ptr(static_cast<Pointer*>(static_cast<void*>(this->m_smart_ptr))) {
-			// we can assume things are cleaner here
-#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
-			assert(*this->m_target_ptr == this->m_old_ptr && "clever UB-based optimization did not properly retrieve the pointer value");
-#endif // Clever Sanity Checks
+		static Pointer* target(std::true_type, Smart& ptr) noexcept {
+			return static_cast<Pointer*>(static_cast<void*>(std::addressof(ptr)));
 		}
 
-		out_unique_fast(std::false_type, Smart& ptr) noexcept
-		: m_smart_ptr(std::addressof(ptr)), m_old_ptr(static_cast<Pointer>(ptr.get())) {
-			// analysis necessary
-			if (is_specialization_of<Smart, boost::movelib::unique_ptr>::value) {
-#if ZTD_OUT_PTR_CLEVER_UNIQUE_MOVELIB_IMPLEMENTATION_FIRST_MEMBER_I_
-				// implementation has Pointer as first member: alias directly
-				void* target = static_cast<void*>(this->m_smart_ptr);
-#else
-				// implementation has Pointer as second member: shift, align, alias
-				constexpr const std::size_t memory_start = std::is_empty<D>::value ? 0 : sizeof(D) + (sizeof(D) % alignof(D));
-				std::size_t max_space				 = sizeof(Smart) - memory_start;
-				void* source						 = static_cast<void*>(static_cast<char*>(static_cast<void*>(this->m_smart_ptr)) + memory_start);
-				void* target						 = std::align(alignof(source_pointer), sizeof(source_pointer), source, max_space);
-#endif
-				// get direct Pointer
-				this->m_target_ptr = static_cast<Pointer*>(target);
+		static Pointer* target(std::false_type, Smart& ptr) noexcept {
+			return static_cast<Pointer*>(layout_t::pointer_address(ptr));
+		}
+
+		Pointer* target() const noexcept {
+			return target(can_aliasing_optimization(), *this->m_smart_ptr);
+		}
+
+		friend struct invoke_access;
+
+		void commit() noexcept {
+			if (this->m_old_ptr != nullptr) {
+				this->m_smart_ptr->get_deleter()(static_cast<source_pointer>(this->m_old_ptr));
 			}
-			else {
-#if ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_
-				// implementation has Pointer as first member: alias directly
-				void* target = static_cast<void*>(this->m_smart_ptr);
-#else
-				// implementation has Pointer as second member: shift, align, alias
-				constexpr const std::size_t memory_start = std::is_empty<D>::value ? 0 : sizeof(D) + (sizeof(D) % alignof(D));
-				std::size_t max_space				 = sizeof(Smart) - memory_start;
-				void* source						 = static_cast<void*>(static_cast<char*>(static_cast<void*>(this->m_smart_ptr)) + memory_start);
-				void* target						 = std::align(alignof(source_pointer), sizeof(source_pointer), source, max_space);
-#endif
-				// get direct Pointer
-				this->m_target_ptr = static_cast<Pointer*>(target);
+			this->m_old_ptr   = nullptr;
+			this->m_smart_ptr = nullptr;
+		}
+
+		// the call failed: the old pointer goes back over whatever the C function wrote
+		void abandon() noexcept {
+			if (this->m_smart_ptr != nullptr) {
+				*this->target()   = this->m_old_ptr;
+				this->m_old_ptr   = nullptr;
+				this->m_smart_ptr = nullptr;
 			}
-#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
-			assert(*this->m_target_ptr == this->m_old_ptr && "clever UB-based optimization did not properly retrieve the pointer value");
-#endif // Clever Sanity Checks
 		}
 
 	public:
 		out_unique_fast(Smart& ptr, std::tuple<>&&) noexcept
-		: out_unique_fast(can_aliasing_optimization(), ptr) {
+		: m_smart_ptr(std::addressof(ptr)), m_old_ptr(ptr.get()) {
+#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
+			assert(*this->target() == this->m_old_ptr && "clever UB-based optimization did not properly retrieve the pointer value");
+#endif // Clever Sanity Checks
+			if (PreNull) {
+				// the C function may leave the output untouched:
+				// make sure that reads as "nothing was written"
+				*this->target() = nullptr;
+			}
 		}
 		out_unique_fast(out_unique_fast&& right) noexcept
-		: m_smart_ptr(right.m_smart_ptr), m_old_ptr(right.m_old_ptr), m_target_ptr(right.m_target_ptr) {
-			right.m_old_ptr = nullptr;
+		: m_smart_ptr(right.m_smart_ptr), m_old_ptr(right.m_old_ptr) {
+			right.m_smart_ptr = nullptr;
+			right.m_old_ptr   = nullptr;
 		}
 		out_unique_fast& operator=(out_unique_fast&& right) noexcept {
-			this->m_smart_ptr  = right.m_smart_ptr;
-			this->m_old_ptr    = right.m_old_ptr;
-			this->m_target_ptr = right.m_target_ptr;
-			right.m_old_ptr    = nullptr;
+			this->m_smart_ptr = right.m_smart_ptr;
+			this->m_old_ptr   = right.m_old_ptr;
+			right.m_smart_ptr = nullptr;
+			right.m_old_ptr   = nullptr;
 			return *this;
 		}
 
 		operator Pointer*() const noexcept {
-			return const_cast<Pointer*>(this->m_target_ptr);
+			return this->target();
 		}
 
 		~out_unique_fast() noexcept {
+			static_assert(sizeof(out_unique_fast) == sizeof(two_words<Smart*, source_pointer>), "the clever adaptor must stay two words");
+			this->commit();
+		}
+	};
+
+	// adopts the C function's output straight into the handle's only member:
+	// the storage is nulled before the call without giving up the old reference,
+	// which is only released afterwards, so the old object stays alive for the
+	// whole call (e.g. p->QueryInterface(iid, out_ptr<void*>(p, false)))
+	template <typename Smart, typename Pointer>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ out_intrusive_fast : public voidpp_op<out_intrusive_fast<Smart, Pointer>, Pointer> {
+	private:
+		using source_pointer = pointer_of_or_t<Smart, Pointer>;
+		// the handle's only member is the target: it is not stored separately
+		Smart* m_smart_ptr;
+		source_pointer m_old_ptr;
+		bool m_add_ref;
+
+		Pointer* target() const noexcept {
+			return static_cast<Pointer*>(static_cast<void*>(this->m_smart_ptr));
+		}
+
+		// hands the old reference to a temporary handle, which gives it up
+		void release_old() noexcept {
 			if (this->m_old_ptr != nullptr) {
-				this->m_smart_ptr->get_deleter()(static_cast<source_pointer>(this->m_old_ptr));
+				Smart old;
+				old.reset(this->m_old_ptr, false);
+				this->m_old_ptr = nullptr;
+			}
+		}
+
+		friend struct invoke_access;
+
+		void commit() noexcept {
+			if (this->m_smart_ptr == nullptr) {
+				return;
+			}
+			Smart& smart_ptr  = *this->m_smart_ptr;
+			Pointer* target	  = this->target();
+			this->m_smart_ptr = nullptr;
+			if (this->m_add_ref) {
+				// otherwise, the written value already is the handle's reference
+				Pointer p = *target;
+				if (p != nullptr) {
+					*target = nullptr;
+					smart_ptr.reset(static_cast<source_pointer>(p), true);
+				}
+			}
+			this->release_old();
+		}
+
+		// the call failed: the old reference goes back over whatever the C function wrote
+		void abandon() noexcept {
+			if (this->m_smart_ptr != nullptr) {
+				*this->target()   = static_cast<Pointer>(this->m_old_ptr);
+				this->m_old_ptr   = nullptr;
+				this->m_smart_ptr = nullptr;
+			}
+		}
+
+	public:
+		template <typename AddRef>
+		out_intrusive_fast(Smart& ptr, std::tuple<AddRef>&& args) noexcept
+		: m_smart_ptr(std::addressof(ptr)), m_old_ptr(ptr.get()), m_add_ref(std::get<0>(args)) {
+#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
+			assert(static_cast<source_pointer>(*this->target()) == this->m_old_ptr && "clever UB-based optimization did not properly retrieve the pointer value");
+#endif // Clever Sanity Checks
+			*this->target() = nullptr;
+		}
+		out_intrusive_fast(out_intrusive_fast&& right) noexcept
+		: m_smart_ptr(right.m_smart_ptr), m_old_ptr(right.m_old_ptr), m_add_ref(right.m_add_ref) {
+			right.m_smart_ptr = nullptr;
+			right.m_old_ptr   = nullptr;
+		}
+		out_intrusive_fast& operator=(out_intrusive_fast&& right) noexcept {
+			this->m_smart_ptr = right.m_smart_ptr;
+			this->m_old_ptr   = right.m_old_ptr;
+			this->m_add_ref   = right.m_add_ref;
+			right.m_smart_ptr = nullptr;
+			right.m_old_ptr   = nullptr;
+			return *this;
+		}
+
+		operator Pointer*() const noexcept {
+			return this->target();
+		}
+
+		~out_intrusive_fast() noexcept {
+			this->commit();
+		}
+	};
+
+	// writes straight into the storage of an integral handle (e.g. a unique file descriptor):
+	// the storage is always emptied before the call, as POSIX-style functions leave
+	// their outputs untouched on failure, and the old value is destroyed afterwards
+	template <typename Smart, typename Pointer>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ out_integral_fast : public voidpp_op<out_integral_fast<Smart, Pointer>, Pointer> {
+	private:
+		// the handle's only member is the target: it is not stored separately
+		Smart* m_smart_ptr;
+		Pointer m_old_value;
+
+		Pointer* target() const noexcept {
+			return static_cast<Pointer*>(static_cast<void*>(this->m_smart_ptr));
+		}
+
+		friend struct invoke_access;
+
+		void commit() noexcept {
+			if (this->m_smart_ptr != nullptr && !handle_is_null(*this->m_smart_ptr, this->m_old_value)) {
+				this->m_smart_ptr->get_deleter()(this->m_old_value);
 			}
+			this->m_smart_ptr = nullptr;
+		}
+
+		// the call failed: the old value goes back in place of the emptied storage
+		void abandon() noexcept {
+			if (this->m_smart_ptr != nullptr) {
+				*this->target()   = this->m_old_value;
+				this->m_smart_ptr = nullptr;
+			}
+		}
+
+	public:
+		out_integral_fast(Smart& ptr, std::tuple<>&&) noexcept
+		: m_smart_ptr(std::addressof(ptr)), m_old_value(ptr.get()) {
+#if ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_
+			assert(*this->target() == this->m_old_value && "clever UB-based optimization did not properly retrieve the handle value");
+#endif // Clever Sanity Checks
+			*this->target() = handle_null<Pointer>(ptr);
+		}
+		out_integral_fast(out_integral_fast&& right) noexcept
+		: m_smart_ptr(right.m_smart_ptr), m_old_value(right.m_old_value) {
+			right.m_smart_ptr = nullptr;
+		}
+		out_integral_fast& operator=(out_integral_fast&& right) noexcept {
+			this->m_smart_ptr = right.m_smart_ptr;
+			this->m_old_value = right.m_old_value;
+			right.m_smart_ptr = nullptr;
+			return *this;
+		}
+
+		operator Pointer*() const noexcept {
+			return this->target();
+		}
+
+		~out_integral_fast() noexcept {
+			static_assert(sizeof(out_integral_fast) == sizeof(two_words<Smart*, Pointer>), "the clever adaptor must stay two words");
+			this->commit();
 		}
 	};
 
-	template <typename Smart, typename Pointer, typename Args, typename List, typename = void>
+	template <typename Smart, typename Pointer, typename Args, typename List, bool PreNull = false, typename = void>
 	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_out_ptr_impl : public base_out_ptr_impl<Smart, Pointer, out_ptr_traits<Smart, Pointer>, Args, List> {
 	private:
 		using base_t = base_out_ptr_impl<Smart, Pointer, out_ptr_traits<Smart, Pointer>, Args, List>;
@@ -133,31 +283,59 @@ namespace op_detail {
 		using base_t::base_t;
 	};
 
-	template <typename T, typename D, typename Pointer>
+	template <typename T, typename D, typename Pointer, bool PreNull>
 	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_out_ptr_impl<std::unique_ptr<T, D>,
-		Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>,
-		typename std::enable_if<std::is_same<pointer_of_or_t<std::unique_ptr<T, D>, Pointer>, Pointer>::value
-			|| op_detail::has_unspecialized_marker<out_ptr_traits<std::unique_ptr<T, D>, Pointer>>::value
-			|| std::is_base_of<pointer_of_or_t<std::unique_ptr<T, D>, Pointer>, Pointer>::value
-			|| !std::is_convertible<pointer_of_or_t<std::unique_ptr<T, D>, Pointer>, Pointer>::value>::type>
-	: public out_unique_fast<std::unique_ptr<T, D>, T, D, Pointer> {
+		Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>, PreNull,
+		typename std::enable_if<op_detail::has_unspecialized_marker<out_ptr_traits<std::unique_ptr<T, D>, Pointer>>::value
+			&& op_detail::is_aliasable_pointer<pointer_of_or_t<std::unique_ptr<T, D>, Pointer>, Pointer>::value
+			&& std_unique_layout<T, D>::matches>::type>
+	: public out_unique_fast<std::unique_ptr<T, D>, T, D, Pointer, PreNull> {
 	private:
-		using base_t = out_unique_fast<std::unique_ptr<T, D>, T, D, Pointer>;
+		using base_t = out_unique_fast<std::unique_ptr<T, D>, T, D, Pointer, PreNull>;
 
 	public:
 		using base_t::base_t;
 	};
 
-	template <typename T, typename D, typename Pointer>
+	template <typename T, typename D, typename Pointer, bool PreNull>
 	struct clever_out_ptr_impl<boost::movelib::unique_ptr<T, D>,
-		Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>,
-		typename std::enable_if<std::is_same<pointer_of_or_t<boost::movelib::unique_ptr<T, D>, Pointer>, Pointer>::value
-			|| op_detail::has_unspecialized_marker<out_ptr_traits<boost::movelib::unique_ptr<T, D>, Pointer>>::value
-			|| std::is_base_of<pointer_of_or_t<boost::movelib::unique_ptr<T, D>, Pointer>, Pointer>::value
-			|| !std::is_convertible<pointer_of_or_t<boost::movelib::unique_ptr<T, D>, Pointer>, Pointer>::value>::type>
-	: public out_unique_fast<boost::movelib::unique_ptr<T, D>, T, D, Pointer> {
+		Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>, PreNull,
+		typename std::enable_if<op_detail::has_unspecialized_marker<out_ptr_traits<boost::movelib::unique_ptr<T, D>, Pointer>>::value
+			&& op_detail::is_aliasable_pointer<pointer_of_or_t<boost::movelib::unique_ptr<T, D>, Pointer>, Pointer>::value
+			&& unique_layout<boost::movelib::unique_ptr<T, D>, D, pointer_of_or_t<boost::movelib::unique_ptr<T, D>, Pointer>, ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ != 0>::matches>::type>
+	: public out_unique_fast<boost::movelib::unique_ptr<T, D>, T, D, Pointer, PreNull> {
+	private:
+		using base_t = out_unique_fast<boost::movelib::unique_ptr<T, D>, T, D, Pointer, PreNull>;
+
+	public:
+		using base_t::base_t;
+	};
+
+	template <typename Smart, typename Pointer, bool PreNull>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_out_ptr_impl<Smart,
+		Pointer, std::tuple<>, ztd::out_ptr::op_detail::index_sequence<>, PreNull,
+		typename std::enable_if<is_integral_handle<Smart, Pointer>::value
+			&& op_detail::has_unspecialized_marker<out_ptr_traits<Smart, Pointer>>::value>::type>
+	: public out_integral_fast<Smart, Pointer> {
+	private:
+		using base_t = out_integral_fast<Smart, Pointer>;
+
+	public:
+		using base_t::base_t;
+	};
+
+	// only the out_ptr(handle, add_ref) form: it is the only one with a meaning for every intrusive handle
+	template <typename Smart, typename Pointer, typename AddRef, bool PreNull>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ clever_out_ptr_impl<Smart,
+		Pointer, std::tuple<AddRef>, ztd::out_ptr::op_detail::index_sequence<0>, PreNull,
+		typename std::enable_if<is_intrusive_handle<Smart>::value
+			&& std::is_same<typename std::decay<AddRef>::type, bool>::value
+			&& op_detail::has_unspecialized_marker<out_ptr_traits<Smart, Pointer>>::value
+			&& op_detail::is_aliasable_pointer<pointer_of_or_t<Smart, Pointer>, Pointer>::value
+			&& sizeof(Smart) == sizeof(pointer_of_or_t<Smart, Pointer>)>::type>
+	: public out_intrusive_fast<Smart, Pointer> {
 	private:
-		using base_t = out_unique_fast<boost::movelib::unique_ptr<T, D>, T, D, Pointer>;
+		using base_t = out_intrusive_fast<Smart, Pointer>;
 
 	public:
 		using base_t::base_t;
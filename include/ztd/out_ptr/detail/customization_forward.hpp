@@ -29,6 +29,9 @@ namespace boost {
 	template <typename>
 	class shared_ptr;
 
+	template <typename>
+	class intrusive_ptr;
+
 } // namespace boost
 
 #endif
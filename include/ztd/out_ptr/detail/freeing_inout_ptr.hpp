@@ -0,0 +1,69 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+#ifndef ZTD_OUT_PTR_DETAIL_FREEING_INOUT_PTR_HPP
+#define ZTD_OUT_PTR_DETAIL_FREEING_INOUT_PTR_HPP
+
+#include <ztd/out_ptr/detail/simple_inout_ptr.hpp>
+#include <ztd/out_ptr/detail/invoke_access.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace ztd {
+namespace out_ptr {
+namespace op_detail {
+
+	// For a C function which frees its input whether or not it succeeds, leaving the freed
+	// value in place on failure. That value cannot be told apart from a new object allocated at
+	// the same address, which is what a successful call commonly returns, so only the result
+	// code can say which one was written: this adaptor does not convert to the output parameter
+	// type, and can only be passed to the C function through ztd::out_ptr::invoke
+	template <typename Smart, typename Pointer, typename... Args>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ freeing_inout_ptr_t {
+	private:
+		using adaptor_t = simple_inout_ptr_t<Smart, Pointer, Args...>;
+
+		adaptor_t m_adaptor;
+
+		friend struct invoke_access;
+
+		void commit() noexcept(noexcept(invoke_access::commit(std::declval<adaptor_t&>()))) {
+			invoke_access::commit(this->m_adaptor);
+		}
+
+		void abandon() noexcept {
+			invoke_access::abandon(this->m_adaptor);
+		}
+
+	public:
+		freeing_inout_ptr_t(Smart& s, Args... args) noexcept(std::is_nothrow_constructible<adaptor_t, Smart&, Args...>::value)
+		: m_adaptor(s, std::forward<Args>(args)...) {
+		}
+
+		template <typename T>
+		operator T() const noexcept {
+			static_assert(std::is_same<T, void>::value && !std::is_same<T, void>::value,
+				"an inout_ptr given frees_input_without_nulling can only be passed to the C function through "
+				"ztd::out_ptr::invoke, since only the result code says whether the value left in it was freed");
+			return T();
+		}
+	};
+
+}}} // namespace ztd::out_ptr::op_detail
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_HANDLE_NULL_HPP
+#define ZTD_OUT_PTR_DETAIL_HANDLE_NULL_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/detail/is_specialization_of.hpp>
+#include <ztd/out_ptr/detail/customization_forward.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ztd {
+namespace out_ptr {
+namespace op_detail {
+
+	// a handle whose "empty" value is not a value-initialized Pointer (e.g. -1 for file descriptors)
+	// says so through its deleter: write_null(Pointer&) and is_null(const Pointer&)
+	template <typename Smart, typename Pointer, typename = void>
+	struct has_null_policy : std::false_type {
+	};
+
+	template <typename Smart, typename Pointer>
+	struct has_null_policy<Smart, Pointer,
+		void_t<decltype(std::declval<Smart&>().get_deleter().write_null(std::declval<Pointer&>())),
+			decltype(std::declval<Smart&>().get_deleter().is_null(std::declval<const Pointer&>()))>>
+	: std::true_type {
+	};
+
+	template <typename Pointer, typename Smart>
+	Pointer handle_null(std::true_type, Smart& s) noexcept {
+		Pointer p;
+		s.get_deleter().write_null(p);
+		return p;
+	}
+
+	template <typename Pointer, typename Smart>
+	Pointer handle_null(std::false_type, Smart&) noexcept {
+		return Pointer {};
+	}
+
+	template <typename Pointer, typename Smart>
+	Pointer handle_null(Smart& s) noexcept {
+		return handle_null<Pointer>(has_null_policy<Smart, Pointer>(), s);
+	}
+
+	template <typename Smart, typename Pointer>
+	bool handle_is_null(std::true_type, Smart& s, const Pointer& p) noexcept {
+		return s.get_deleter().is_null(p);
+	}
+
+	template <typename Smart, typename Pointer>
+	bool handle_is_null(std::false_type, Smart&, const Pointer& p) noexcept {
+		return p == Pointer {};
+	}
+
+	template <typename Smart, typename Pointer>
+	bool handle_is_null(Smart& s, const Pointer& p) noexcept {
+		return handle_is_null(has_null_policy<Smart, Pointer>(), s, p);
+	}
+
+	// an integral (or enumeration) handle stored as the only member of Smart,
+	// such as a unique file descriptor: its storage can be written directly
+	template <typename Smart, typename Pointer>
+	struct is_integral_handle : std::integral_constant<bool,
+		(std::is_integral<Pointer>::value || std::is_enum<Pointer>::value)
+		&& std::is_same<pointer_of_or_t<Smart, Pointer>, Pointer>::value
+		&& has_null_policy<Smart, Pointer>::value
+		&& std::is_standard_layout<Smart>::value
+		&& sizeof(Smart) == sizeof(Pointer)
+		&& !is_specialization_of<Smart, std::unique_ptr>::value
+		&& !is_specialization_of<Smart, boost::movelib::unique_ptr>::value> {
+	};
+
+}}} // namespace ztd::out_ptr::op_detail
+
+#endif
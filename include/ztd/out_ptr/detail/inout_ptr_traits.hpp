@@ -45,6 +45,8 @@ namespace out_ptr {
 		using pointer = Pointer;
 
 	private:
+		template <typename T>
+		friend struct op_detail::has_unspecialized_marker;
 		using OUT_PTR_DETAIL_UNSPECIALIZED_MARKER_ = int;
 		using defer_t						   = out_ptr_traits<Smart, Pointer>;
 
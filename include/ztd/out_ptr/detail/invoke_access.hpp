@@ -0,0 +1,60 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_INVOKE_ACCESS_HPP
+#define ZTD_OUT_PTR_DETAIL_INVOKE_ACCESS_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace out_ptr { namespace op_detail {
+
+	struct invoke_access {
+		template <typename Adaptor>
+		static auto has_hooks(int) -> decltype(std::declval<Adaptor&>().commit(), std::declval<Adaptor&>().abandon(), std::true_type());
+
+		template <typename Adaptor>
+		static std::false_type has_hooks(...);
+
+		template <typename Adaptor>
+		static void commit(Adaptor& adaptor) noexcept(noexcept(adaptor.commit())) {
+			adaptor.commit();
+		}
+
+		template <typename Adaptor>
+		static void abandon(Adaptor& adaptor) noexcept(noexcept(adaptor.abandon())) {
+			adaptor.abandon();
+		}
+
+		// the simple adaptor an invoke-only adaptor keeps, which is what the C function is given
+		template <typename Adaptor>
+		static auto inner(Adaptor& adaptor) noexcept -> decltype((adaptor.m_adaptor)) {
+			return adaptor.m_adaptor;
+		}
+
+		// gives up on a simple adaptor and hands back the handle it was writing into
+		template <typename Smart, typename Adaptor>
+		static Smart& disarm(Adaptor& adaptor) noexcept {
+			Smart& smart_ptr = *adaptor.m_smart_ptr;
+			adaptor.m_smart_ptr = nullptr;
+			return smart_ptr;
+		}
+	};
+
+}}} // namespace ztd::out_ptr::op_detail
+
+#endif
@@ -0,0 +1,41 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_IS_ALIASABLE_POINTER_HPP
+#define ZTD_OUT_PTR_DETAIL_IS_ALIASABLE_POINTER_HPP
+
+#include <type_traits>
+
+namespace ztd {
+namespace out_ptr {
+namespace op_detail {
+
+	template <typename T>
+	using is_void_pointer = std::integral_constant<bool, std::is_pointer<T>::value && std::is_void<typename std::remove_pointer<T>::type>::value>;
+
+	// whether a Pointer can be written straight over a stored Source:
+	// only when no conversion (a base class adjustment, a handle wrapper, ...) is needed
+	template <typename Source, typename Pointer>
+	using is_aliasable_pointer = std::integral_constant<bool,
+		std::is_same<Source, Pointer>::value
+		|| (std::is_pointer<Source>::value && std::is_pointer<Pointer>::value
+			&& (is_void_pointer<Source>::value || is_void_pointer<Pointer>::value))>;
+
+}}} // namespace ztd::out_ptr::op_detail
+
+#endif
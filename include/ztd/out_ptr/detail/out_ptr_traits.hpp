@@ -20,6 +20,9 @@
 #define ZTD_OUT_PTR_DETAIL_OUT_PTR_TRAITS_HPP
 
 #include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/lazy_arg.hpp>
+#include <ztd/out_ptr/commits_null_as_empty.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
 
 #include <type_traits>
 #include <utility>
@@ -38,6 +41,53 @@ namespace out_ptr {
 			s = Smart(std::forward<Args>(args)...);
 		}
 
+		template <typename Arg>
+		Arg&& materialize(std::false_type, Arg&& arg) noexcept {
+			return std::forward<Arg>(arg);
+		}
+
+		template <typename Arg>
+		auto materialize(std::true_type, Arg&& arg) -> decltype(arg()) {
+			return arg();
+		}
+
+		template <typename Arg>
+		auto materialize(Arg&& arg) -> decltype(materialize(is_lazy_arg<typename std::decay<Arg>::type>(), std::forward<Arg>(arg))) {
+			return materialize(is_lazy_arg<typename std::decay<Arg>::type>(), std::forward<Arg>(arg));
+		}
+
+		template <typename... Args>
+		struct any_lazy_arg : std::false_type {};
+
+		template <typename Arg, typename... Args>
+		struct any_lazy_arg<Arg, Args...>
+		: std::integral_constant<bool, is_lazy_arg<typename std::decay<Arg>::type>::value || any_lazy_arg<Args...>::value> {};
+
+		// a null output is committed as an empty handle, without touching the arguments,
+		// for shared_ptr-likes (no control block) and whenever an argument is lazy (never built)
+		template <typename Smart, typename... Args>
+		using elides_null_commit = std::integral_constant<bool, commits_null_as_empty<Smart>::value || any_lazy_arg<Args...>::value>;
+
+		template <typename Smart, typename Pointer, typename... Args>
+		void commit_or_create(std::false_type, Smart& s, Pointer&& p, Args&&... args) noexcept {
+			using can_reset = is_resetable<Smart, Pointer, decltype(materialize(std::forward<Args>(args)))...>;
+			reset_or_create(can_reset(), s, std::forward<Pointer>(p), materialize(std::forward<Args>(args))...);
+		}
+
+		template <typename Smart, typename Pointer, typename... Args>
+		void commit_or_create(std::true_type, Smart& s, Pointer&& p, Args&&... args) noexcept {
+			if (handle_is_null(s, p)) {
+				reset_or_create(is_resetable<Smart>(), s);
+				return;
+			}
+			commit_or_create(std::false_type(), s, std::forward<Pointer>(p), std::forward<Args>(args)...);
+		}
+
+		template <typename Smart, typename Pointer, typename... Args>
+		void commit_or_create(Smart& s, Pointer&& p, Args&&... args) noexcept {
+			commit_or_create(elides_null_commit<Smart, Args...>(), s, std::forward<Pointer>(p), std::forward<Args>(args)...);
+		}
+
 		template <typename Traits, typename Smart, typename Pointer>
 		auto call_traits_get(std::true_type, Smart& s, Pointer& p) noexcept -> decltype(Traits::get(std::declval<Smart&>(), std::declval<Pointer&>())) {
 			return Traits::get(s, p);
@@ -69,6 +119,19 @@ namespace out_ptr {
 
 			static constexpr const bool value = std::is_same<decltype(test<T>(0)), std::true_type>::value;
 		};
+
+		// inout traits whose storage remembers the input they handed to the C function, which
+		// need not be what the handle holds, say themselves whether it was left in place
+		template <typename T>
+		struct has_traits_unchanged_call {
+			template <typename C>
+			static std::true_type test(decltype(&C::unchanged)*);
+
+			template <typename>
+			static std::false_type test(...);
+
+			static constexpr const bool value = std::is_same<decltype(test<T>(0)), std::true_type>::value;
+		};
 	} // namespace op_detail
 
 	template <typename Smart, typename Pointer>
@@ -82,9 +145,11 @@ namespace out_ptr {
 	public:
 		using pointer = Pointer;
 
+		// starts out as the handle's own empty value, so a C function which
+		// does not write on failure does not leave e.g. fd 0 behind
 		template <typename... Args>
-		static pointer construct(Smart&, Args&&...) noexcept {
-			return pointer {};
+		static pointer construct(Smart& s, Args&&...) noexcept {
+			return op_detail::handle_null<pointer>(s);
 		}
 
 		static typename std::add_pointer<pointer>::type get(Smart&, pointer& p) {
@@ -93,8 +158,7 @@ namespace out_ptr {
 
 		template <typename... Args>
 		static void reset(Smart& s, pointer& p, Args&&... args) noexcept {
-			using can_reset = op_detail::is_resetable<Smart, source_pointer, Args...>;
-			reset_or_create(can_reset(), s, static_cast<source_pointer>(std::move(p)), std::forward<Args>(args)...);
+			op_detail::commit_or_create(s, static_cast<source_pointer>(std::move(p)), std::forward<Args>(args)...);
 		}
 	};
 
@@ -0,0 +1,228 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_PREALLOCATED_OUT_PTR_TRAITS_HPP
+#define ZTD_OUT_PTR_DETAIL_PREALLOCATED_OUT_PTR_TRAITS_HPP
+
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/detail/customization_forward.hpp>
+#include <ztd/out_ptr/detail/is_specialization_of.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace ztd {
+namespace out_ptr {
+
+	namespace op_detail {
+
+		// the deleter that lives inside of a preallocated control block:
+		// the control block itself only ever owns a null pointer, so the
+		// real resource is kept here and written in at commit time
+		template <typename Source, typename Deleter>
+		struct preallocated_deleter {
+			Deleter deleter;
+			Source ptr;
+
+			template <typename Ignored>
+			void operator()(Ignored&&) noexcept(noexcept(std::declval<Deleter&>()(std::declval<Source&>()))) {
+				if (this->ptr != nullptr) {
+					this->deleter(this->ptr);
+				}
+			}
+		};
+
+		template <typename Slot, typename Smart>
+		Slot* find_preallocated_deleter(const Smart& s) noexcept {
+			// finds boost::get_deleter through ADL, too
+			using std::get_deleter;
+			return get_deleter<Slot>(s);
+		}
+
+		template <typename T, typename Source>
+		void alias_assign(std::shared_ptr<T>& s, std::shared_ptr<T> owner, Source p) noexcept {
+#if __cplusplus > 201703L
+			// no reference count traffic: the ownership is moved
+			s = std::shared_ptr<T>(std::move(owner), p);
+#else
+			s = std::shared_ptr<T>(owner, p);
+#endif
+		}
+
+		template <typename Smart, typename Source>
+		void alias_assign(Smart& s, Smart owner, Source p) noexcept {
+			s = Smart(owner, p);
+		}
+
+	} // namespace op_detail
+
+	template <typename Smart, typename Pointer, typename Deleter, bool Recycle = false>
+	class preallocated_out_ptr_traits {
+	private:
+		using source_pointer = pointer_of_or_t<Smart, Pointer>;
+		using slot_t		    = op_detail::preallocated_deleter<source_pointer, Deleter>;
+
+		struct preallocated_state {
+			Pointer target;
+			Smart block;
+			slot_t* slot;
+			bool recycled;
+
+			preallocated_state(Smart block_, slot_t* slot_, bool recycled_) noexcept
+			: target(), block(std::move(block_)), slot(slot_), recycled(recycled_) {
+			}
+		};
+
+		template <typename D, typename... Rest>
+		static preallocated_state allocate(D&& d, Rest&&... rest) {
+			Smart block(static_cast<source_pointer>(nullptr), slot_t { std::forward<D>(d), nullptr }, std::forward<Rest>(rest)...);
+			slot_t* slot = op_detail::find_preallocated_deleter<slot_t>(block);
+			return preallocated_state(std::move(block), slot, false);
+		}
+
+	public:
+		using pointer = preallocated_state;
+
+		template <typename D, typename... Rest>
+		static pointer construct(Smart& s, D&& d, Rest&&... rest) {
+			static_assert(op_detail::is_specialization_of<Smart, std::shared_ptr>::value || op_detail::is_specialization_of<Smart, boost::shared_ptr>::value,
+				"control block preallocation is only meaningful for shared_ptr-like types");
+			static_assert(std::is_same<typename std::decay<D>::type, Deleter>::value,
+				"the first argument to preallocated_out_ptr must be the deleter");
+			if (Recycle && s.use_count() == 1) {
+				slot_t* slot = op_detail::find_preallocated_deleter<slot_t>(s);
+				if (slot != nullptr) {
+					// the only owner is the one we are writing into:
+					// reuse its control block rather than making a new one
+					return preallocated_state(Smart(), slot, true);
+				}
+			}
+			return allocate(std::forward<D>(d), std::forward<Rest>(rest)...);
+		}
+
+		static Pointer* get(Smart&, pointer& p) noexcept {
+			return std::addressof(p.target);
+		}
+
+		template <typename... Args>
+		static void reset(Smart& s, pointer& p, Args&&...) noexcept {
+			source_pointer committed = static_cast<source_pointer>(p.target);
+			if (p.recycled) {
+				// recycled: swap the resource held in the existing control block
+				source_pointer old = p.slot->ptr;
+				p.slot->ptr		= committed;
+				op_detail::alias_assign(s, std::move(s), committed);
+				if (old != nullptr) {
+					p.slot->deleter(old);
+				}
+				return;
+			}
+			if (committed == nullptr) {
+				// a null output is committed as an empty handle: the unused control block
+				// goes away with p, without calling the deleter
+				s.reset();
+				return;
+			}
+			// preallocated: all that is left is to store the pointer and publish it
+			p.slot->ptr = committed;
+			op_detail::alias_assign(s, std::move(p.block), committed);
+		}
+	};
+
+	// inout_ptr for shared_ptr: only possible when s is the one owner of its object, as otherwise
+	// the C function would free or move an object other owners still use. That is known for sure
+	// when s's control block was made by preallocated_out_ptr or one of the recycling adaptors,
+	// and s.use_count() == 1: the C function is then given the object and the control block
+	// is reseated onto what it writes back. An empty s makes a new control block; anything else
+	// cannot be given to the C function, and is rejected before the call rather than given null
+	template <typename Smart, typename Pointer, typename Deleter>
+	class recycling_inout_ptr_traits {
+	private:
+		using source_pointer = pointer_of_or_t<Smart, Pointer>;
+		using slot_t		    = op_detail::preallocated_deleter<source_pointer, Deleter>;
+
+		struct recycling_state {
+			Pointer target;
+			Smart block;
+			slot_t* slot;
+			bool recycled;
+
+			recycling_state(Pointer target_, Smart block_, slot_t* slot_, bool recycled_) noexcept
+			: target(target_), block(std::move(block_)), slot(slot_), recycled(recycled_) {
+			}
+		};
+
+	public:
+		using pointer = recycling_state;
+
+		static bool accepts(const Smart& s) noexcept {
+			return s.use_count() == 0 || (s.use_count() == 1 && op_detail::find_preallocated_deleter<slot_t>(s) != nullptr);
+		}
+
+		template <typename D, typename... Rest>
+		static pointer construct(Smart& s, D&& d, Rest&&... rest) {
+			static_assert(op_detail::is_specialization_of<Smart, std::shared_ptr>::value || op_detail::is_specialization_of<Smart, boost::shared_ptr>::value,
+				"control block recycling is only meaningful for shared_ptr-like types");
+			static_assert(std::is_same<typename std::decay<D>::type, Deleter>::value,
+				"the first argument to recycling_inout_ptr must be the deleter");
+			if (s.use_count() != 0) {
+				slot_t* slot = s.use_count() == 1 ? op_detail::find_preallocated_deleter<slot_t>(s) : nullptr;
+				if (slot == nullptr) {
+					throw std::invalid_argument("recycling_inout_ptr: the shared_ptr has other owners, or its control block was not made by preallocated_out_ptr or recycling_out_ptr with this deleter");
+				}
+				return recycling_state(static_cast<Pointer>(slot->ptr), Smart(), slot, true);
+			}
+			Smart block(static_cast<source_pointer>(nullptr), slot_t { std::forward<D>(d), nullptr }, std::forward<Rest>(rest)...);
+			slot_t* slot = op_detail::find_preallocated_deleter<slot_t>(block);
+			return recycling_state(Pointer(), std::move(block), slot, false);
+		}
+
+		static Pointer* get(Smart&, pointer& p) noexcept {
+			return std::addressof(p.target);
+		}
+
+		// whether the C function left its input where it was, i.e. whether there is nothing to commit
+		static bool unchanged(const pointer& p) noexcept {
+			return p.target == (p.recycled ? static_cast<Pointer>(p.slot->ptr) : Pointer());
+		}
+
+		template <typename... Args>
+		static void reset(Smart& s, pointer& p, Args&&...) noexcept {
+			// the C function has taken over the input: it is not destroyed here
+			source_pointer committed = static_cast<source_pointer>(p.target);
+			if (p.recycled) {
+				p.slot->ptr = committed;
+				op_detail::alias_assign(s, std::move(s), committed);
+				return;
+			}
+			if (committed == nullptr) {
+				// as with preallocated_out_ptr, the fresh control block is not kept for nothing
+				s.reset();
+				return;
+			}
+			p.slot->ptr = committed;
+			op_detail::alias_assign(s, std::move(p.block), committed);
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
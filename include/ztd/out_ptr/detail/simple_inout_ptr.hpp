@@ -38,7 +38,7 @@ namespace op_detail {
 		using core_t = base_inout_ptr_impl<Smart, Pointer, std::tuple<Args...>, list_t>;
 
 	public:
-		simple_inout_ptr_t(Smart& s, Args... args) noexcept
+		simple_inout_ptr_t(Smart& s, Args... args) noexcept(std::is_nothrow_constructible<core_t, Smart&, std::tuple<Args...>&&>::value)
 		: core_t(s, std::forward_as_tuple(std::forward<Args>(args)...)) {
 		}
 	};
@@ -0,0 +1,109 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_DETAIL_UNIQUE_LAYOUT_HPP
+#define ZTD_OUT_PTR_DETAIL_UNIQUE_LAYOUT_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace ztd {
+namespace out_ptr {
+namespace op_detail {
+
+	template <typename D>
+	struct is_empty_base_deleter : std::integral_constant<bool, std::is_class<D>::value && std::is_empty<D>::value
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+		&& !std::is_final<D>::value
+#endif
+		> {
+	};
+
+	// how many bytes the deleter takes up inside of the smart pointer:
+	// references are stored as pointers, empty deleters as empty bases
+	template <typename D, typename = void>
+	struct stored_deleter {
+		static constexpr const std::size_t size  = is_empty_base_deleter<D>::value ? 0 : sizeof(D);
+		static constexpr const std::size_t align = is_empty_base_deleter<D>::value ? 1 : alignof(D);
+	};
+
+	template <typename D>
+	struct stored_deleter<D, typename std::enable_if<std::is_reference<D>::value>::type> {
+		static constexpr const std::size_t size  = sizeof(void*);
+		static constexpr const std::size_t align = alignof(void*);
+	};
+
+	inline constexpr std::size_t layout_round_up(std::size_t n, std::size_t alignment) noexcept {
+		return ((n + alignment - 1) / alignment) * alignment;
+	}
+
+	inline constexpr std::size_t layout_max(std::size_t left, std::size_t right) noexcept {
+		return left < right ? right : left;
+	}
+
+	// a "unique"-style smart pointer as a { pointer, deleter } or { deleter, pointer } pair
+	template <typename Smart, typename D, typename Source, bool PointerFirst>
+	struct unique_layout {
+		using deleter_t = stored_deleter<D>;
+
+		static constexpr const std::size_t offset = PointerFirst ? 0 : layout_round_up(deleter_t::size, alignof(Source));
+		static constexpr const std::size_t alignment = layout_max(alignof(Source), deleter_t::align);
+		static constexpr const std::size_t expected_size = PointerFirst
+			? layout_round_up(layout_round_up(sizeof(Source), deleter_t::align) + deleter_t::size, alignment)
+			: layout_round_up(offset + sizeof(Source), alignment);
+		// a cheap guard against a layout this model does not describe
+		static constexpr const bool matches = sizeof(Smart) == expected_size;
+
+		static void* pointer_address(Smart& smart) noexcept {
+			return static_cast<void*>(static_cast<char*>(static_cast<void*>(std::addressof(smart))) + offset);
+		}
+	};
+
+	template <typename D>
+	struct std_unique_pointer_first : std::integral_constant<bool,
+		std::is_reference<D>::value ? ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ != 0 : ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ != 0> {
+	};
+
+	template <typename T, typename D>
+	using std_unique_layout = unique_layout<std::unique_ptr<T, D>, D, typename std::unique_ptr<T, D>::pointer, std_unique_pointer_first<D>::value>;
+
+#if ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_
+	// the same deleter the configure-time probe measured with
+	struct unique_layout_probe_deleter {
+		unsigned char state[12];
+
+		void operator()(int*) const {
+		}
+	};
+
+	static_assert(ZTD_OUT_PTR_PROBED_UNIQUE_STDLIB == ZTD_OUT_PTR_STDLIB_I_,
+		"the unique_ptr layout probe was generated for a different standard library: re-run the CMake configure step");
+	static_assert(std_unique_layout<int, unique_layout_probe_deleter>::offset == ZTD_OUT_PTR_PROBED_UNIQUE_STATEFUL_OFFSET
+			&& sizeof(std::unique_ptr<int, unique_layout_probe_deleter>) == ZTD_OUT_PTR_PROBED_UNIQUE_STATEFUL_SIZE,
+		"std::unique_ptr with a stateful deleter no longer has the layout measured at configure time: re-run the CMake configure step");
+	static_assert(std_unique_layout<int, unique_layout_probe_deleter&>::offset == ZTD_OUT_PTR_PROBED_UNIQUE_REFERENCE_OFFSET
+			&& sizeof(std::unique_ptr<int, unique_layout_probe_deleter&>) == ZTD_OUT_PTR_PROBED_UNIQUE_REFERENCE_SIZE,
+		"std::unique_ptr with a reference deleter no longer has the layout measured at configure time: re-run the CMake configure step");
+#endif
+
+}}} // namespace ztd::out_ptr::op_detail
+
+#endif
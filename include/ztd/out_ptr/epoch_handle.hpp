@@ -0,0 +1,384 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_EPOCH_HANDLE_HPP
+#define ZTD_OUT_PTR_EPOCH_HANDLE_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/pointer_of.hpp>
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/inout_ptr_traits.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ztd { namespace out_ptr {
+
+	namespace op_detail {
+		// one per thread which ever read an epoch_handle: reused by later threads once its own
+		// thread exits, and never freed
+		struct epoch_reader_record {
+			// the epoch this thread entered its read-side section in, or 0 outside of one
+			std::atomic<std::uint64_t> epoch;
+			std::atomic<bool> in_use;
+			// set before the record is shared, and never changed after
+			epoch_reader_record* next;
+			// nested sections: only ever touched by the thread which owns the record
+			std::size_t depth;
+			// keeps the next record's epoch off of this one's cache line
+			char padding[64];
+		};
+
+		// The epochs and readers of every epoch_handle. Writers advance the epoch whenever they
+		// retire an object, and an object retired at epoch r is destroyed once no reader is still
+		// in a section it entered before r. Trivially destructible on purpose, so that threads
+		// which exit late can still give their record back.
+		class epoch_domain {
+		private:
+			std::atomic<std::uint64_t> m_epoch;
+			std::atomic<epoch_reader_record*> m_records;
+
+		public:
+			constexpr epoch_domain() noexcept : m_epoch(1), m_records(nullptr) {
+			}
+
+			static epoch_domain& global() noexcept {
+				static epoch_domain domain;
+				return domain;
+			}
+
+			std::uint64_t current() const noexcept {
+				return m_epoch.load(std::memory_order_seq_cst);
+			}
+
+			// the epoch an object retired right now is tagged with
+			std::uint64_t advance() noexcept {
+				return m_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+			}
+
+			// the oldest epoch a reader is in, or the largest epoch there is if none is reading
+			std::uint64_t oldest_reader() const noexcept {
+				std::uint64_t oldest = ~std::uint64_t(0);
+				for (const epoch_reader_record* record = m_records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+					std::uint64_t epoch = record->epoch.load(std::memory_order_seq_cst);
+					if (epoch != 0 && epoch < oldest) {
+						oldest = epoch;
+					}
+				}
+				return oldest;
+			}
+
+			epoch_reader_record& acquire_record() {
+				for (epoch_reader_record* record = m_records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+					bool free = false;
+					if (!record->in_use.load(std::memory_order_relaxed)
+						&& record->in_use.compare_exchange_strong(free, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+						record->depth = 0;
+						return *record;
+					}
+				}
+				epoch_reader_record* record = new epoch_reader_record();
+				record->epoch.store(0, std::memory_order_relaxed);
+				record->in_use.store(true, std::memory_order_relaxed);
+				record->depth			   = 0;
+				epoch_reader_record* head = m_records.load(std::memory_order_relaxed);
+				do {
+					record->next = head;
+				} while (!m_records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+				return *record;
+			}
+		};
+
+		struct epoch_thread_record {
+			epoch_reader_record* record;
+
+			~epoch_thread_record() {
+				if (record != nullptr) {
+					record->epoch.store(0, std::memory_order_release);
+					record->in_use.store(false, std::memory_order_release);
+				}
+			}
+		};
+
+		inline epoch_reader_record& this_thread_epoch_record() {
+			static thread_local epoch_thread_record thread_record = { nullptr };
+			if (thread_record.record == nullptr) {
+				thread_record.record = &epoch_domain::global().acquire_record();
+			}
+			return *thread_record.record;
+		}
+
+		// a read-side section which can be moved around, e.g. inside an inout_ptr's storage
+		class epoch_section {
+		private:
+			epoch_reader_record* m_record;
+
+		public:
+			epoch_section() : m_record(&this_thread_epoch_record()) {
+				if (m_record->depth++ == 0) {
+					// seq_cst: a writer which does not see this store yet has already published
+					// whatever replaces the object this section is about to load
+					m_record->epoch.store(epoch_domain::global().current(), std::memory_order_seq_cst);
+				}
+			}
+
+			epoch_section(epoch_section&& right) noexcept : m_record(right.m_record) {
+				right.m_record = nullptr;
+			}
+
+			epoch_section& operator=(epoch_section&& right) noexcept {
+				exit();
+				m_record		 = right.m_record;
+				right.m_record = nullptr;
+				return *this;
+			}
+
+			epoch_section(const epoch_section&)			 = delete;
+			epoch_section& operator=(const epoch_section&) = delete;
+
+			void exit() noexcept {
+				if (m_record == nullptr) {
+					return;
+				}
+				if (--m_record->depth == 0) {
+					m_record->epoch.store(0, std::memory_order_release);
+				}
+				m_record = nullptr;
+			}
+
+			~epoch_section() {
+				exit();
+			}
+		};
+
+		template <typename Pointer>
+		struct epoch_re_create_storage {
+			Pointer expected;
+			Pointer desired;
+			// keeps the input alive while the C function reads it
+			epoch_section section;
+		};
+	} // namespace op_detail
+
+	// Marks a read-side section on the calling thread: whatever an epoch_handle's load()
+	// returns inside of it is not destroyed until the section ends. Sections nest, never block,
+	// and only cost a store and a fence to enter.
+	class epoch_guard {
+	private:
+		op_detail::epoch_section m_section;
+
+	public:
+		epoch_guard() : m_section() {
+		}
+
+		epoch_guard(const epoch_guard&)			 = delete;
+		epoch_guard& operator=(const epoch_guard&) = delete;
+	};
+
+	// An owner for read-mostly objects: readers load it without a lock inside an epoch_guard,
+	// while writers publish new objects into it. A replaced object is retired rather than
+	// destroyed, and only destroyed by a later write (or reclaim()) once every reader which
+	// could still be using it has left its section.
+	template <typename T, typename D = std::default_delete<T>>
+	class epoch_handle {
+	public:
+		using element_type = T;
+		using deleter_type = D;
+		using pointer		 = pointer_type_t<T*, D>;
+
+	private:
+		struct retired_object {
+			pointer object;
+			std::uint64_t epoch;
+		};
+
+		std::atomic<pointer> m_ptr;
+		deleter_type m_deleter;
+		mutable std::mutex m_retired_lock;
+		std::vector<retired_object> m_retired;
+
+		void reclaim_locked() noexcept {
+			std::uint64_t oldest = op_detail::epoch_domain::global().oldest_reader();
+			std::size_t kept	 = 0;
+			for (std::size_t i = 0; i < m_retired.size(); ++i) {
+				if (m_retired[i].epoch <= oldest) {
+					m_deleter(m_retired[i].object);
+				}
+				else {
+					m_retired[kept] = m_retired[i];
+					++kept;
+				}
+			}
+			m_retired.resize(kept);
+		}
+
+		void retire(pointer old) noexcept {
+			if (old == pointer()) {
+				return;
+			}
+			retired_object retired = { old, op_detail::epoch_domain::global().advance() };
+			std::lock_guard<std::mutex> lock(m_retired_lock);
+			m_retired.push_back(retired);
+			reclaim_locked();
+		}
+
+	public:
+		epoch_handle() noexcept : m_ptr(pointer()), m_deleter(), m_retired_lock(), m_retired() {
+		}
+
+		explicit epoch_handle(pointer p) noexcept : m_ptr(p), m_deleter(), m_retired_lock(), m_retired() {
+		}
+
+		epoch_handle(pointer p, deleter_type d) noexcept : m_ptr(p), m_deleter(std::move(d)), m_retired_lock(), m_retired() {
+		}
+
+		epoch_handle(const epoch_handle&)			 = delete;
+		epoch_handle& operator=(const epoch_handle&) = delete;
+
+		// nothing may be reading it anymore
+		~epoch_handle() {
+			for (std::size_t i = 0; i < m_retired.size(); ++i) {
+				m_deleter(m_retired[i].object);
+			}
+			pointer p = m_ptr.load(std::memory_order_relaxed);
+			if (p != pointer()) {
+				m_deleter(p);
+			}
+		}
+
+		// only valid until the calling thread's epoch_guard ends
+		pointer load() const noexcept {
+			return m_ptr.load(std::memory_order_seq_cst);
+		}
+
+		pointer get() const noexcept {
+			return load();
+		}
+
+		explicit operator bool() const noexcept {
+			return load() != pointer();
+		}
+
+		deleter_type& get_deleter() noexcept {
+			return m_deleter;
+		}
+
+		const deleter_type& get_deleter() const noexcept {
+			return m_deleter;
+		}
+
+		// publishes p, and retires what it replaced
+		void reset(pointer p = pointer()) noexcept {
+			retire(m_ptr.exchange(p, std::memory_order_seq_cst));
+		}
+
+		// publishes desired, and retires expected, only if expected is still the published
+		// object; otherwise, expected is updated to what is published instead
+		bool compare_exchange(pointer& expected, pointer desired) noexcept {
+			if (!m_ptr.compare_exchange_strong(expected, desired, std::memory_order_seq_cst)) {
+				return false;
+			}
+			retire(expected);
+			return true;
+		}
+
+		// destroys the retired objects no reader can be using anymore
+		void reclaim() noexcept {
+			std::lock_guard<std::mutex> lock(m_retired_lock);
+			reclaim_locked();
+		}
+
+		// retired objects which are still waiting on a reader
+		std::size_t retired() const noexcept {
+			std::lock_guard<std::mutex> lock(m_retired_lock);
+			return m_retired.size();
+		}
+	};
+
+	template <typename T, typename D, typename Pointer>
+	class out_ptr_traits<epoch_handle<T, D>, Pointer> {
+	private:
+		using smart_t		  = epoch_handle<T, D>;
+		using source_pointer = typename smart_t::pointer;
+
+	public:
+		using pointer = Pointer;
+
+		static pointer construct(smart_t&) noexcept {
+			return pointer();
+		}
+
+		static typename std::add_pointer<pointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p);
+		}
+
+		static void reset(smart_t& s, pointer& p) noexcept {
+			s.reset(static_cast<source_pointer>(p));
+		}
+	};
+
+	// The C function is given the published object, inside a read-side section so that no other
+	// writer can destroy it meanwhile, and must neither free nor change it: readers may still be
+	// using it. What it writes back is published with a compare-and-swap, and the input retired.
+	template <typename T, typename D, typename Pointer>
+	class inout_ptr_traits<epoch_handle<T, D>, Pointer> {
+	private:
+		using smart_t		  = epoch_handle<T, D>;
+		using source_pointer = typename smart_t::pointer;
+
+	public:
+		using pointer = op_detail::epoch_re_create_storage<Pointer>;
+
+		static pointer construct(smart_t& s) {
+			op_detail::epoch_section section;
+			Pointer current = static_cast<Pointer>(s.load());
+			return pointer { current, current, std::move(section) };
+		}
+
+		static typename std::add_pointer<Pointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p.desired);
+		}
+
+		static void reset(smart_t& s, pointer& p) noexcept {
+			// the input is only compared against from here on: it need not be kept alive
+			p.section.exit();
+			source_pointer expected = static_cast<source_pointer>(p.expected);
+			source_pointer desired  = static_cast<source_pointer>(p.desired);
+			if (desired == expected) {
+				// left alone, e.g. because the call failed
+				return;
+			}
+			if (s.compare_exchange(expected, desired)) {
+				return;
+			}
+			// another writer published first: this output was never seen by a reader
+			if (desired != source_pointer()) {
+				s.get_deleter()(desired);
+			}
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
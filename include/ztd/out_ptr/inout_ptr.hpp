@@ -23,8 +23,10 @@
 
 #include <ztd/out_ptr/detail/clever_inout_ptr.hpp>
 #include <ztd/out_ptr/detail/simple_inout_ptr.hpp>
+#include <ztd/out_ptr/detail/freeing_inout_ptr.hpp>
 #include <ztd/out_ptr/detail/inout_ptr_traits.hpp>
 #include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/ownership_policy.hpp>
 
 #include <cstddef>
 
@@ -34,11 +36,39 @@ namespace out_ptr {
 	namespace op_detail {
 #if ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR_I_
 		template <typename Smart, typename Pointer, typename... Args>
-		using core_inout_ptr_t = clever_inout_ptr_t<Smart, Pointer, Args...>;
+		using default_core_inout_ptr_t = clever_inout_ptr_t<Smart, Pointer, Args...>;
 #else
 		template <typename Smart, typename Pointer, typename... Args>
-		using core_inout_ptr_t = simple_inout_ptr_t<Smart, Pointer, Args...>;
+		using default_core_inout_ptr_t = simple_inout_ptr_t<Smart, Pointer, Args...>;
 #endif // ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR
+
+		// if the input is never left dangling, aliasing the storage is always correct:
+		// the smart pointer keeps the old value exactly as long as the C function does
+		template <typename Policy, typename Smart, typename Pointer, typename... Args>
+		struct policy_core_inout_ptr {
+			using type = clever_inout_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		// a freed-but-not-nulled input cannot be told apart from a new value
+		// that happens to have the same address, so only the result code can
+		// say what happened: only ztd::out_ptr::invoke may pass it to the C function
+		template <typename Smart, typename Pointer, typename... Args>
+		struct policy_core_inout_ptr<frees_input_without_nulling_t, Smart, Pointer, Args...> {
+			using type = freeing_inout_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		template <bool HasPolicy, typename Smart, typename Pointer, typename... Args>
+		struct select_core_inout_ptr {
+			using type = default_core_inout_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		template <typename Smart, typename Pointer, typename Policy, typename... Args>
+		struct select_core_inout_ptr<true, Smart, Pointer, Policy, Args...> {
+			using type = policy_ptr_t<typename policy_core_inout_ptr<typename std::decay<Policy>::type, Smart, Pointer, Args...>::type, Smart, Policy, Args...>;
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		using core_inout_ptr_t = typename select_core_inout_ptr<starts_with_ownership_policy<Args...>::value, Smart, Pointer, Args...>::type;
 	} // namespace op_detail
 
 	template <typename Smart, typename Pointer, typename... Args>
@@ -0,0 +1,285 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_INVOKE_HPP
+#define ZTD_OUT_PTR_INVOKE_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+#include <ztd/out_ptr/aliasing_out_ptr.hpp>
+#include <ztd/out_ptr/ownership_policy.hpp>
+#include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
+#include <ztd/out_ptr/detail/invoke_access.hpp>
+#include <ztd/out_ptr/detail/clever_out_ptr.hpp>
+#include <ztd/out_ptr/detail/simple_out_ptr.hpp>
+#include <ztd/out_ptr/detail/inout_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/integer_sequence.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+namespace ztd { namespace out_ptr {
+
+	namespace op_detail {
+
+		// adaptors written by the library; a user's own out_ptr_t / inout_ptr_t
+		// specialization is passed through and commits as it always did
+		template <typename Adaptor>
+		struct is_checked_adaptor : std::false_type {};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct is_checked_adaptor<out_ptr_t<Smart, Pointer, Args...>> : decltype(invoke_access::has_hooks<out_ptr_t<Smart, Pointer, Args...>>(0)) {};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct is_checked_adaptor<inout_ptr_t<Smart, Pointer, Args...>> : decltype(invoke_access::has_hooks<inout_ptr_t<Smart, Pointer, Args...>>(0)) {};
+
+		template <typename Smart, typename Pointer, typename Owner>
+		struct is_checked_adaptor<aliasing_out_ptr_t<Smart, Pointer, Owner>> : decltype(invoke_access::has_hooks<aliasing_out_ptr_t<Smart, Pointer, Owner>>(0)) {};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct is_checked_adaptor<recycling_inout_ptr_t<Smart, Pointer, Args...>> : decltype(invoke_access::has_hooks<recycling_inout_ptr_t<Smart, Pointer, Args...>>(0)) {};
+
+		template <typename Smart, typename T, typename D, typename Pointer, bool PreNull>
+		std::true_type is_out_unique_fast(const out_unique_fast<Smart, T, D, Pointer, PreNull>*);
+
+		std::false_type is_out_unique_fast(...);
+
+		template <bool IsSimple, typename Smart, typename Pointer>
+		struct is_aliasable_out_ptr : std::false_type {};
+
+		template <typename Smart, typename Pointer>
+		struct is_aliasable_out_ptr<true, Smart, Pointer> : decltype(is_out_unique_fast(static_cast<clever_out_ptr_t<Smart, Pointer>*>(nullptr))) {};
+
+		// a simple out_ptr into a unique_ptr only stays off the handle's storage because
+		// a failing C function may leave garbage there: once the result says which it was,
+		// the old pointer can be put back, so the storage is written into directly
+		template <typename Adaptor>
+		struct is_aliasable_adaptor : std::false_type {};
+
+		template <typename Smart, typename Pointer>
+		struct is_aliasable_adaptor<out_ptr_t<Smart, Pointer>>
+		: is_aliasable_out_ptr<std::is_base_of<simple_out_ptr_t<Smart, Pointer>, out_ptr_t<Smart, Pointer>>::value, Smart, Pointer> {};
+
+		// only the result code says a failing call freed the input, so now it can be released
+		template <typename Adaptor>
+		struct is_freeing_adaptor : std::false_type {};
+
+		template <typename Smart, typename Pointer, typename Policy, typename... Args>
+		struct is_freeing_adaptor<inout_ptr_t<Smart, Pointer, Policy, Args...>>
+		: std::integral_constant<bool, std::is_same<typename std::decay<Policy>::type, frees_input_without_nulling_t>::value
+			&& is_checked_adaptor<inout_ptr_t<Smart, Pointer, Policy, Args...>>::value> {};
+
+		template <typename Adaptor>
+		struct adaptor_parts;
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct adaptor_parts<out_ptr_t<Smart, Pointer, Args...>> {
+			using smart_t = Smart;
+			using pointer = Pointer;
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct adaptor_parts<inout_ptr_t<Smart, Pointer, Args...>> {
+			using smart_t = Smart;
+			using pointer = Pointer;
+		};
+
+		template <typename Adaptor>
+		using invoke_kind = std::integral_constant<int,
+			is_aliasable_adaptor<typename std::decay<Adaptor>::type>::value ? 3
+			: is_freeing_adaptor<typename std::decay<Adaptor>::type>::value ? 2
+			: is_checked_adaptor<typename std::decay<Adaptor>::type>::value ? 1
+			: 0>;
+
+		// anything else: passed to the C function untouched
+		template <typename Arg, typename Kind = invoke_kind<Arg>>
+		class checked_arg {
+		private:
+			Arg&& m_arg;
+
+		public:
+			checked_arg(Arg&& arg) noexcept
+			: m_arg(std::forward<Arg>(arg)) {
+			}
+
+			Arg&& get() noexcept {
+				return std::forward<Arg>(this->m_arg);
+			}
+
+			void commit() noexcept {
+			}
+
+			void abandon() noexcept {
+			}
+		};
+
+		// a throwing C function or predicate counts as a failure
+		template <typename Adaptor>
+		class checked_arg<Adaptor, std::integral_constant<int, 1>> {
+		private:
+			using adaptor_t = typename std::decay<Adaptor>::type;
+
+			adaptor_t& m_adaptor;
+			bool m_done;
+
+		public:
+			checked_arg(Adaptor&& adaptor) noexcept
+			: m_adaptor(adaptor), m_done(false) {
+			}
+
+			adaptor_t& get() noexcept {
+				return this->m_adaptor;
+			}
+
+			void commit() {
+				this->m_done = true;
+				invoke_access::commit(this->m_adaptor);
+			}
+
+			void abandon() noexcept {
+				this->m_done = true;
+				invoke_access::abandon(this->m_adaptor);
+			}
+
+			~checked_arg() {
+				if (!this->m_done) {
+					invoke_access::abandon(this->m_adaptor);
+				}
+			}
+		};
+
+		// the adaptor cannot be passed to the C function by itself: it is given the simple
+		// adaptor inside, and the result code says whether what is left in it was freed
+		template <typename Adaptor>
+		class checked_arg<Adaptor, std::integral_constant<int, 2>> {
+		private:
+			using adaptor_t = typename std::decay<Adaptor>::type;
+			using smart_t	= typename adaptor_parts<adaptor_t>::smart_t;
+			using inner_t	= typename std::remove_reference<decltype(invoke_access::inner(std::declval<adaptor_t&>()))>::type;
+
+			adaptor_t& m_adaptor;
+			bool m_done;
+
+			static void forget(std::true_type, smart_t& ptr) noexcept {
+				ptr = nullptr;
+			}
+
+			static void forget(std::false_type, smart_t& ptr) noexcept {
+				call_release(is_releasable<smart_t>(), ptr);
+			}
+
+		public:
+			checked_arg(Adaptor&& adaptor) noexcept
+			: m_adaptor(adaptor), m_done(false) {
+			}
+
+			inner_t& get() noexcept {
+				return invoke_access::inner(this->m_adaptor);
+			}
+
+			void commit() {
+				this->m_done = true;
+				invoke_access::commit(this->m_adaptor);
+			}
+
+			void abandon() noexcept {
+				this->m_done = true;
+				// whatever is left in the storage was freed by the C function
+				forget(std::is_pointer<smart_t>(), invoke_access::disarm<smart_t>(invoke_access::inner(this->m_adaptor)));
+			}
+
+			~checked_arg() {
+				if (!this->m_done) {
+					this->abandon();
+				}
+			}
+		};
+
+		template <typename Adaptor>
+		class checked_arg<Adaptor, std::integral_constant<int, 3>> {
+		private:
+			using adaptor_t = typename std::decay<Adaptor>::type;
+			using smart_t	= typename adaptor_parts<adaptor_t>::smart_t;
+			using aliased_t = clever_out_ptr_t<smart_t, typename adaptor_parts<adaptor_t>::pointer>;
+
+			aliased_t m_aliased;
+			bool m_done;
+
+		public:
+			checked_arg(Adaptor&& adaptor) noexcept
+			: m_aliased(invoke_access::disarm<smart_t>(adaptor)), m_done(false) {
+			}
+
+			aliased_t& get() noexcept {
+				return this->m_aliased;
+			}
+
+			void commit() noexcept {
+				this->m_done = true;
+				invoke_access::commit(this->m_aliased);
+			}
+
+			void abandon() noexcept {
+				this->m_done = true;
+				invoke_access::abandon(this->m_aliased);
+			}
+
+			~checked_arg() {
+				if (!this->m_done) {
+					invoke_access::abandon(this->m_aliased);
+				}
+			}
+		};
+
+		template <typename Arg>
+		using checked_pass_t = decltype(std::declval<checked_arg<Arg>&>().get());
+
+		template <typename R, typename F, typename Pred, typename Checked, std::size_t... Indices>
+		R invoke_checked(F&& f, Pred&& pred, Checked& checked, ztd::out_ptr::op_detail::index_sequence<Indices...>) {
+			R result = std::forward<F>(f)(std::get<Indices>(checked).get()...);
+			if (std::forward<Pred>(pred)(static_cast<const typename std::remove_reference<R>::type&>(result))) {
+				int expander[] = { 0, (std::get<Indices>(checked).commit(), 0)... };
+				(void)expander;
+			}
+			else {
+				int expander[] = { 0, (std::get<Indices>(checked).abandon(), 0)... };
+				(void)expander;
+			}
+			return result;
+		}
+	} // namespace op_detail
+
+	// calls the C function with out_ptr / inout_ptr arguments and commits them
+	// only if the success predicate accepts the result; on failure every handle is left
+	// as it was before the call, without any reset or deleter call. Either way, the handles
+	// are settled by the time invoke returns, not at the end of the full expression
+	template <typename F, typename Pred, typename... Args>
+	auto invoke(F&& f, Pred&& pred, Args&&... args) -> decltype(std::forward<F>(f)(std::declval<op_detail::checked_pass_t<Args>>()...)) {
+		using R = decltype(std::forward<F>(f)(std::declval<op_detail::checked_pass_t<Args>>()...));
+		static_assert(!std::is_void<R>::value, "a function returning void has no result to tell success from failure: call it directly instead");
+		std::tuple<op_detail::checked_arg<Args>...> checked(std::forward<Args>(args)...);
+		return op_detail::invoke_checked<R>(std::forward<F>(f), std::forward<Pred>(pred), checked, ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>());
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
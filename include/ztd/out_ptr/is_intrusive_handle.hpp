@@ -0,0 +1,41 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_IS_INTRUSIVE_HANDLE_HPP
+#define ZTD_OUT_PTR_IS_INTRUSIVE_HANDLE_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/customization_forward.hpp>
+
+#include <type_traits>
+
+namespace ztd { namespace out_ptr {
+
+	// A handle whose only member is the pointer to a reference-counted object,
+	// where .reset() releases the held reference and .reset(p, add_ref)
+	// adopts p, taking a new reference only when add_ref is true.
+	// Specialize this for other types with the same shape.
+	template <typename Smart>
+	struct is_intrusive_handle : std::false_type {};
+
+	template <typename T>
+	struct is_intrusive_handle<boost::intrusive_ptr<T>> : std::true_type {};
+
+}} // namespace ztd::out_ptr
+
+#endif
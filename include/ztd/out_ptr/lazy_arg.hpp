@@ -0,0 +1,59 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_LAZY_ARG_HPP
+#define ZTD_OUT_PTR_LAZY_ARG_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace out_ptr {
+
+	// An argument (usually a stateful deleter) which is only built, by calling f(),
+	// when a non-null value is committed into the smart pointer:
+	// a C function which fails never pays for constructing it
+	template <typename F>
+	class lazy_arg_t {
+	public:
+		explicit lazy_arg_t(F f) noexcept(std::is_nothrow_move_constructible<F>::value)
+		: m_f(std::move(f)) {
+		}
+
+		auto operator()() -> decltype(std::declval<F&>()()) {
+			return this->m_f();
+		}
+
+	private:
+		F m_f;
+	};
+
+	template <typename F>
+	lazy_arg_t<typename std::decay<F>::type> lazy_arg(F&& f) noexcept(std::is_nothrow_constructible<typename std::decay<F>::type, F>::value) {
+		return lazy_arg_t<typename std::decay<F>::type>(std::forward<F>(f));
+	}
+
+	template <typename T>
+	struct is_lazy_arg : std::false_type {};
+
+	template <typename F>
+	struct is_lazy_arg<lazy_arg_t<F>> : std::true_type {};
+
+}} // namespace ztd::out_ptr
+
+#endif
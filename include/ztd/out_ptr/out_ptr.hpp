@@ -25,6 +25,9 @@
 #include <ztd/out_ptr/detail/clever_out_ptr.hpp>
 #include <ztd/out_ptr/detail/out_ptr_traits.hpp>
 #include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/ownership_policy.hpp>
+#include <ztd/out_ptr/is_intrusive_handle.hpp>
+#include <ztd/out_ptr/static_deleter.hpp>
 #include <ztd/out_ptr/pointer_of.hpp>
 
 #include <type_traits>
@@ -38,14 +41,63 @@ namespace ztd { namespace out_ptr {
 		// One must opt into this specifically because it is unsafe for a large
 		// variety of APIs
 		template <typename Smart, typename Pointer, typename... Args>
-		using core_out_ptr_t = clever_out_ptr_t<Smart, Pointer, Args...>;
+		using default_core_out_ptr_t = clever_out_ptr_t<Smart, Pointer, Args...>;
 #else
 		// we can never use the clever version by default
 		// because many C APIs do not set
 		// the pointer to null on parameter failure
+		// (the intrusive, integral and static deleter paths excepted, when turned on:
+		// they are emptied before the call)
+		template <typename Smart, typename Pointer>
+		using is_emptied_before_call = std::integral_constant<bool,
+			(ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ != 0 && is_intrusive_handle<Smart>::value)
+			|| (ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ != 0 && is_integral_handle<Smart, Pointer>::value)>;
+
+		// a unique_ptr with a static deleter is the size of its pointer:
+		// it can be nulled up-front and written into directly instead
+		template <typename Smart>
+		using is_prenulled_before_call = std::integral_constant<bool,
+			ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ != 0 && is_static_deleter_handle<Smart>::value>;
+
 		template <typename Smart, typename Pointer, typename... Args>
-		using core_out_ptr_t = simple_out_ptr_t<Smart, Pointer, Args...>;
+		using default_core_out_ptr_t = typename std::conditional<is_emptied_before_call<Smart, Pointer>::value,
+			clever_out_ptr_t<Smart, Pointer, Args...>,
+			typename std::conditional<is_prenulled_before_call<Smart>::value,
+				prenull_out_ptr_t<Smart, Pointer, Args...>, simple_out_ptr_t<Smart, Pointer, Args...>>::type>::type;
 #endif // ZTD_OUT_PTR_USE_CLEVER_OUT_PTR
+
+		// a C function that says how it behaves on failure gets
+		// the cheapest implementation that is still correct for it
+		template <typename Policy, typename Smart, typename Pointer, typename... Args>
+		struct policy_core_out_ptr;
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct policy_core_out_ptr<null_on_failure_t, Smart, Pointer, Args...> {
+			using type = clever_out_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct policy_core_out_ptr<unchanged_on_failure_t, Smart, Pointer, Args...> {
+			using type = prenull_out_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct policy_core_out_ptr<frees_input_without_nulling_t, Smart, Pointer, Args...> {
+			using type = simple_out_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		template <bool HasPolicy, typename Smart, typename Pointer, typename... Args>
+		struct select_core_out_ptr {
+			using type = default_core_out_ptr_t<Smart, Pointer, Args...>;
+		};
+
+		template <typename Smart, typename Pointer, typename Policy, typename... Args>
+		struct select_core_out_ptr<true, Smart, Pointer, Policy, Args...> {
+			using type = policy_ptr_t<typename policy_core_out_ptr<typename std::decay<Policy>::type, Smart, Pointer, Args...>::type, Smart, Policy, Args...>;
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		using core_out_ptr_t = typename select_core_out_ptr<starts_with_ownership_policy<Args...>::value, Smart, Pointer, Args...>::type;
 	} // namespace op_detail
 
 	template <typename Smart, typename Pointer, typename... Args>
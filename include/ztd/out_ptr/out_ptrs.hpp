@@ -0,0 +1,258 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_OUT_PTRS_HPP
+#define ZTD_OUT_PTR_OUT_PTRS_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/necessary_arity.hpp>
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
+#include <ztd/out_ptr/detail/handle_null.hpp>
+#include <ztd/out_ptr/detail/integer_sequence.hpp>
+#include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+namespace ztd { namespace out_ptr {
+
+	// every output is committed on its own, as separate out_ptr calls would
+	struct commit_each_t {};
+	// the outputs are committed only if every one of them is non-null: otherwise the smart pointers
+	// keep their old values, and whichever outputs were written are destroyed
+	struct all_or_nothing_t {};
+
+	constexpr const commit_each_t commit_each {};
+	constexpr const all_or_nothing_t all_or_nothing {};
+
+	template <typename T>
+	struct is_out_ptrs_policy : std::false_type {};
+
+	template <>
+	struct is_out_ptrs_policy<commit_each_t> : std::true_type {};
+
+	template <>
+	struct is_out_ptrs_policy<all_or_nothing_t> : std::true_type {};
+
+	// one output of out_ptrs which needs arguments to commit (e.g. a shared_ptr's deleter),
+	// or a pointer type other than the smart pointer's own
+	template <typename Smart, typename Pointer, typename... Args>
+	class out_arg_t {
+	public:
+		Smart* smart_ptr;
+		std::tuple<Args...> args;
+
+		out_arg_t(Smart& s, Args... args_) noexcept
+		: smart_ptr(std::addressof(s)), args(std::forward<Args>(args_)...) {
+		}
+	};
+
+	template <typename Pointer = op_detail::marker, typename Smart, typename... Args>
+	out_arg_t<Smart, typename std::conditional<std::is_same<Pointer, op_detail::marker>::value, pointer_of_t<Smart>, Pointer>::type, Args...> out_arg(
+		Smart& s, Args&&... args) noexcept {
+		return { s, std::forward<Args>(args)... };
+	}
+
+	namespace op_detail {
+
+		template <typename Smart, typename Pointer, typename Args, typename List>
+		class out_ptrs_output;
+
+		// a single smart pointer written by out_ptrs: what an out_ptr_t holds, without committing on its own
+		template <typename Smart, typename Pointer, typename... Args, std::size_t... Indices>
+		class out_ptrs_output<Smart, Pointer, std::tuple<Args...>, ztd::out_ptr::op_detail::index_sequence<Indices...>> {
+		private:
+			using traits_t = out_ptr_traits<Smart, Pointer>;
+			using storage  = pointer_of_or_t<traits_t, Pointer>;
+			using args_t   = std::tuple<compressed_arg_t<Args>...>;
+
+			static_assert(sizeof...(Args) >= necessary_arity<Smart, Args...>::value,
+				"out_ptrs requires certain arguments to be passed in for use with this type "
+				"(e.g. shared_ptr<T> must be passed through out_arg with a deleter, so when reset is called the "
+				"deleter can be properly initialized, otherwise the deleter will be "
+				"defaulted by the shared_ptr<T>::reset() call!)");
+
+			Smart* m_smart_ptr;
+			args_t m_args;
+			storage m_target_ptr;
+
+		public:
+			using pointer = Pointer;
+
+			out_ptrs_output(Smart& s) noexcept
+			: m_smart_ptr(std::addressof(s)), m_args(), m_target_ptr(traits_t::construct(s)) {
+			}
+
+			out_ptrs_output(out_arg_t<Smart, Pointer, Args...>&& arg) noexcept
+			: m_smart_ptr(arg.smart_ptr), m_args(std::move(arg.args)), m_target_ptr(traits_t::construct(*this->m_smart_ptr, std::get<Indices>(this->m_args)...)) {
+			}
+
+			out_ptrs_output(out_ptrs_output&& right) noexcept
+			: m_smart_ptr(right.m_smart_ptr), m_args(std::move(right.m_args)), m_target_ptr(std::move(right.m_target_ptr)) {
+				right.m_smart_ptr = nullptr;
+			}
+			out_ptrs_output& operator=(out_ptrs_output&& right) noexcept {
+				this->m_smart_ptr  = right.m_smart_ptr;
+				this->m_args	   = std::move(right.m_args);
+				this->m_target_ptr = std::move(right.m_target_ptr);
+				right.m_smart_ptr  = nullptr;
+				return *this;
+			}
+
+			bool active() const noexcept {
+				return this->m_smart_ptr != nullptr;
+			}
+
+			Pointer* get() noexcept {
+				using has_get_call = std::integral_constant<bool, has_traits_get_call<traits_t>::value>;
+				return call_traits_get<traits_t>(has_get_call(), *this->m_smart_ptr, this->m_target_ptr);
+			}
+
+			bool written() const noexcept {
+				return !handle_is_null(*this->m_smart_ptr, this->m_target_ptr);
+			}
+
+			void commit() noexcept {
+				(void)this->m_args; // unused if "Indices" is empty
+				traits_t::reset(*this->m_smart_ptr, this->m_target_ptr, std::get<Indices>(std::move(this->m_args))...);
+			}
+
+			// hands a written output to a smart pointer of its own, which destroys it
+			// the same way the target would have
+			void discard() noexcept {
+				static_assert(std::is_default_constructible<Smart>::value, "out_ptrs with all_or_nothing needs default-constructible smart pointers, to destroy the outputs it does not commit");
+				if (!this->written()) {
+					return;
+				}
+				Smart discarded {};
+				(void)this->m_args; // unused if "Indices" is empty
+				traits_t::reset(discarded, this->m_target_ptr, std::get<Indices>(std::move(this->m_args))...);
+			}
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		using out_ptrs_output_t = out_ptrs_output<Smart, Pointer, std::tuple<Args...>, ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>>;
+
+		template <typename T>
+		struct out_ptrs_output_of {
+			using type = out_ptrs_output_t<T, pointer_of_t<T>>;
+		};
+
+		template <typename Smart, typename Pointer, typename... Args>
+		struct out_ptrs_output_of<out_arg_t<Smart, Pointer, Args...>> {
+			using type = out_ptrs_output_t<Smart, Pointer, Args...>;
+		};
+	} // namespace op_detail
+
+	template <typename Policy, typename... Outputs>
+	class out_ptrs_t {
+	private:
+		using outputs_t = std::tuple<Outputs...>;
+		using list_t	= ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Outputs)>;
+
+		static_assert(sizeof...(Outputs) > 0, "out_ptrs requires at least one output");
+
+		outputs_t m_outputs;
+
+		template <std::size_t... Indices>
+		void commit(commit_each_t, ztd::out_ptr::op_detail::index_sequence<Indices...>) noexcept {
+			int expander[] = { (std::get<Indices>(this->m_outputs).commit(), 0)... };
+			(void)expander;
+		}
+
+		template <std::size_t... Indices>
+		void commit(all_or_nothing_t, ztd::out_ptr::op_detail::index_sequence<Indices...>) noexcept {
+			bool all_written	  = true;
+			int written_expander[] = { (all_written = all_written && std::get<Indices>(this->m_outputs).written(), 0)... };
+			(void)written_expander;
+			if (all_written) {
+				this->commit(commit_each_t(), list_t());
+				return;
+			}
+			int discard_expander[] = { (std::get<Indices>(this->m_outputs).discard(), 0)... };
+			(void)discard_expander;
+		}
+
+	public:
+		template <typename... Sources>
+		out_ptrs_t(Policy, Sources&&... sources) noexcept
+		: m_outputs(Outputs(std::forward<Sources>(sources))...) {
+		}
+
+		out_ptrs_t(out_ptrs_t&& right) noexcept = default;
+		out_ptrs_t& operator=(out_ptrs_t&& right) noexcept = default;
+
+		// the output the C function writes for the I-th smart pointer
+		template <std::size_t I>
+		typename std::tuple_element<I, outputs_t>::type::pointer* get() noexcept {
+			return std::get<I>(this->m_outputs).get();
+		}
+
+		~out_ptrs_t() noexcept {
+			// every output is moved together, so the first says if this one was moved from
+			if (!std::get<0>(this->m_outputs).active()) {
+				return;
+			}
+			this->commit(Policy(), list_t());
+		}
+	};
+
+	namespace op_detail {
+		template <typename First, typename... Args>
+		struct out_ptrs_result {
+			using type = out_ptrs_t<commit_each_t, typename out_ptrs_output_of<First>::type, typename out_ptrs_output_of<Args>::type...>;
+		};
+
+		template <typename... Args>
+		struct out_ptrs_result<commit_each_t, Args...> {
+			using type = out_ptrs_t<commit_each_t, typename out_ptrs_output_of<Args>::type...>;
+		};
+
+		template <typename... Args>
+		struct out_ptrs_result<all_or_nothing_t, Args...> {
+			using type = out_ptrs_t<all_or_nothing_t, typename out_ptrs_output_of<Args>::type...>;
+		};
+
+		template <typename Result, typename... Args>
+		Result out_ptrs_tagged(std::false_type, Args&&... args) noexcept {
+			return Result(commit_each_t(), std::forward<Args>(args)...);
+		}
+
+		template <typename Result, typename Policy, typename... Args>
+		Result out_ptrs_tagged(std::true_type, Policy&& policy, Args&&... args) noexcept {
+			return Result(std::forward<Policy>(policy), std::forward<Args>(args)...);
+		}
+	} // namespace op_detail
+
+	// for C functions which write several owning outputs at once, e.g. create_pair(A** a, B** b):
+	// one object, committing every output when it is destroyed
+	template <typename First, typename... Rest>
+	typename op_detail::out_ptrs_result<typename std::decay<First>::type, typename std::decay<Rest>::type...>::type out_ptrs(First&& first, Rest&&... rest) noexcept {
+		using P = typename op_detail::out_ptrs_result<typename std::decay<First>::type, typename std::decay<Rest>::type...>::type;
+		return op_detail::out_ptrs_tagged<P>(is_out_ptrs_policy<typename std::decay<First>::type>(), std::forward<First>(first), std::forward<Rest>(rest)...);
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
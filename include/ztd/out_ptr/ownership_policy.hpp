@@ -0,0 +1,72 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_OWNERSHIP_POLICY_HPP
+#define ZTD_OUT_PTR_OWNERSHIP_POLICY_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace out_ptr {
+
+	// the C function always writes its output parameter, with a null value on failure
+	struct null_on_failure_t {};
+	// the C function does not touch its output parameter on failure
+	struct unchanged_on_failure_t {};
+	// the C function frees its input parameter, even on failure, without writing a null value
+	struct frees_input_without_nulling_t {};
+
+	constexpr const null_on_failure_t null_on_failure {};
+	constexpr const unchanged_on_failure_t unchanged_on_failure {};
+	constexpr const frees_input_without_nulling_t frees_input_without_nulling {};
+
+	template <typename T>
+	struct is_ownership_policy : std::false_type {};
+
+	template <>
+	struct is_ownership_policy<null_on_failure_t> : std::true_type {};
+
+	template <>
+	struct is_ownership_policy<unchanged_on_failure_t> : std::true_type {};
+
+	template <>
+	struct is_ownership_policy<frees_input_without_nulling_t> : std::true_type {};
+
+	namespace op_detail {
+		template <typename... Args>
+		struct starts_with_ownership_policy : std::false_type {};
+
+		template <typename First, typename... Args>
+		struct starts_with_ownership_policy<First, Args...> : is_ownership_policy<typename std::decay<First>::type> {};
+
+		// takes the policy tag off the front of the arguments,
+		// so the chosen implementation never sees it
+		template <typename Base, typename Smart, typename Policy, typename... Args>
+		class ZTD_OUT_PTR_TRIVIAL_ABI_I_ policy_ptr_t : public Base {
+		public:
+			policy_ptr_t(Smart& s, Policy, Args... args) noexcept(std::is_nothrow_constructible<Base, Smart&, Args...>::value)
+			: Base(s, std::forward<Args>(args)...) {
+			}
+		};
+	} // namespace op_detail
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -109,8 +109,19 @@ namespace out_ptr {
 	template <typename T, typename U>
 	using pointer_of_or_t = typename pointer_of_or<T, U>::type;
 
+	namespace op_detail {
+		template <typename T>
+		struct rebound_element_pointer {
+			using type = typename std::pointer_traits<T>::element_type*;
+		};
+	} // namespace op_detail
+
+	// std::pointer_traits is only asked when T has neither ::pointer nor ::element_type,
+	// so a handle type which is not a template (e.g. a unique_fd) only needs ::pointer
 	template <typename T>
-	using pointer_of = pointer_of_or<T, typename std::pointer_traits<T>::element_type*>;
+	struct pointer_of : std::conditional<std::is_void<typename op_detail::pointer_of_or<T, void>::type>::value,
+		op_detail::rebound_element_pointer<T>, op_detail::pointer_of_or<T, void>>::type {
+	};
 
 	template <typename T>
 	using pointer_of_t = typename pointer_of<T>::type;
@@ -0,0 +1,209 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_POOLED_HANDLE_HPP
+#define ZTD_OUT_PTR_POOLED_HANDLE_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/inout_ptr_traits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace out_ptr {
+
+	// counts for the calling thread's pool only
+	struct handle_pool_stats {
+		// inout_ptr found a warm handle to give the C function
+		std::size_t hits;
+		// inout_ptr found the pool empty, and gave the C function a null input
+		std::size_t misses;
+		// handles kept for re-use instead of being destroyed
+		std::size_t recycled;
+		// handles destroyed because the pool was full, drained, or its thread was exiting
+		std::size_t destroyed;
+	};
+
+	namespace op_detail {
+		template <typename F>
+		struct destroy_argument;
+
+		template <typename R, typename P>
+		struct destroy_argument<R (*)(P)> {
+			using type = P;
+		};
+
+#if defined(__cpp_noexcept_function_type) && (__cpp_noexcept_function_type >= 201510L)
+		template <typename R, typename P>
+		struct destroy_argument<R (*)(P) noexcept> {
+			using type = P;
+		};
+#endif
+
+		// trivially destructible on purpose: it stays usable while the
+		// thread's other thread_local objects are being torn down
+		template <typename Pointer, std::size_t Capacity>
+		struct handle_pool_state {
+			Pointer slots[Capacity];
+			std::size_t count;
+			handle_pool_stats stats;
+			bool drained;
+		};
+	} // namespace op_detail
+
+	// A per-thread cache of released C handles, which are handed back to C functions that
+	// can re-create into an existing object (e.g. a no-alloc "re_create") instead of
+	// destroying and allocating one. Each thread only ever touches its own slots, so
+	// nothing is locked or shared; handles left over when a thread exits are destroyed.
+	template <typename F, F Destroy, std::size_t Capacity = 64>
+	class handle_pool {
+	public:
+		using pointer = typename op_detail::destroy_argument<F>::type;
+
+	private:
+		static_assert(Capacity > 0, "a handle pool must be able to hold at least one handle");
+
+		using state_t = op_detail::handle_pool_state<pointer, Capacity>;
+
+		static state_t& this_thread_state() noexcept {
+			static thread_local state_t state = {};
+			return state;
+		}
+
+		static void destroy_all(state_t& state) noexcept {
+			while (state.count != 0) {
+				--state.count;
+				++state.stats.destroyed;
+				(void)Destroy(state.slots[state.count]);
+			}
+		}
+
+		struct drainer {
+			~drainer() {
+				state_t& state = this_thread_state();
+				state.drained  = true;
+				destroy_all(state);
+			}
+		};
+
+		static state_t& this_thread_pool() noexcept {
+			// registers the drainer the first time this thread keeps a handle
+			static thread_local drainer pool_drainer;
+			(void)pool_drainer;
+			return this_thread_state();
+		}
+
+	public:
+		// a warm handle from this thread's pool, or null if there is none
+		static pointer acquire() noexcept {
+			state_t& state = this_thread_state();
+			if (state.count == 0) {
+				++state.stats.misses;
+				return nullptr;
+			}
+			++state.stats.hits;
+			--state.count;
+			return state.slots[state.count];
+		}
+
+		// keeps the handle for re-use, or destroys it if this thread's pool is full
+		static void recycle(pointer p) noexcept {
+			state_t& state = this_thread_state();
+			if (state.drained || state.count == Capacity) {
+				++state.stats.destroyed;
+				(void)Destroy(p);
+				return;
+			}
+			this_thread_pool();
+			state.slots[state.count] = p;
+			++state.count;
+			++state.stats.recycled;
+		}
+
+		// destroys every handle this thread's pool holds
+		static void drain() noexcept {
+			destroy_all(this_thread_state());
+		}
+
+		static std::size_t size() noexcept {
+			return this_thread_state().count;
+		}
+
+		static handle_pool_stats stats() noexcept {
+			return this_thread_state().stats;
+		}
+	};
+
+	// Gives handles back to the calling thread's handle_pool rather than destroying them.
+	template <typename F, F Destroy, std::size_t Capacity = 64>
+	struct basic_pooled_deleter {
+		using pool = handle_pool<F, Destroy, Capacity>;
+
+		void operator()(typename pool::pointer p) const noexcept {
+			pool::recycle(p);
+		}
+	};
+
+	template <typename T, typename F, F Destroy, std::size_t Capacity = 64>
+	using basic_pooled_handle = std::unique_ptr<T, basic_pooled_deleter<F, Destroy, Capacity>>;
+
+#if ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_
+	template <auto Destroy, std::size_t Capacity = 64>
+	using pooled_deleter = basic_pooled_deleter<decltype(Destroy), Destroy, Capacity>;
+
+	template <typename T, auto Destroy, std::size_t Capacity = 64>
+	using pooled_handle = std::unique_ptr<T, pooled_deleter<Destroy, Capacity>>;
+#endif // auto template parameters
+
+	// an empty pooled handle gives the C function a warm object from the pool to
+	// re-create into, where it would otherwise have been given null and had to allocate
+	template <typename T, typename F, F Destroy, std::size_t Capacity, typename Pointer>
+	class inout_ptr_traits<std::unique_ptr<T, basic_pooled_deleter<F, Destroy, Capacity>>, Pointer> {
+	private:
+		using smart_t = std::unique_ptr<T, basic_pooled_deleter<F, Destroy, Capacity>>;
+		using defer_t = out_ptr_traits<smart_t, Pointer>;
+		using pool_t  = handle_pool<F, Destroy, Capacity>;
+
+	public:
+		using pointer = Pointer;
+
+		template <typename... Args>
+		static pointer construct(smart_t& s, Args&&...) noexcept {
+			if (s) {
+				return static_cast<pointer>(s.get());
+			}
+			return static_cast<pointer>(pool_t::acquire());
+		}
+
+		static typename std::add_pointer<pointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p);
+		}
+
+		template <typename... Args>
+		static void reset(smart_t& s, pointer& p, Args&&... args) noexcept {
+			s.release();
+			defer_t::reset(s, p, std::forward<Args>(args)...);
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
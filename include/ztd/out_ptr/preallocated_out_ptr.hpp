@@ -0,0 +1,162 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_PREALLOCATED_OUT_PTR_HPP
+#define ZTD_OUT_PTR_PREALLOCATED_OUT_PTR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/base_out_ptr_impl.hpp>
+#include <ztd/out_ptr/detail/preallocated_out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/integer_sequence.hpp>
+#include <ztd/out_ptr/detail/marker.hpp>
+#include <ztd/out_ptr/pointer_of.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+namespace ztd { namespace out_ptr {
+
+	namespace op_detail {
+		template <typename... Args>
+		struct first_decayed_or_void {
+			using type = void;
+		};
+
+		template <typename First, typename... Args>
+		struct first_decayed_or_void<First, Args...> {
+			using type = typename std::decay<First>::type;
+		};
+
+		template <typename Smart, typename Pointer, bool Recycle, typename... Args>
+		using preallocated_traits_t = preallocated_out_ptr_traits<Smart, Pointer, typename first_decayed_or_void<Args...>::type, Recycle>;
+
+		template <typename Smart, typename Pointer, typename... Args>
+		using recycling_inout_traits_t = recycling_inout_ptr_traits<Smart, Pointer, typename first_decayed_or_void<Args...>::type>;
+	} // namespace op_detail
+
+	template <typename Smart, typename Pointer, bool Recycle, typename... Args>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ preallocated_out_ptr_t
+	: public op_detail::base_out_ptr_impl<Smart, Pointer, op_detail::preallocated_traits_t<Smart, Pointer, Recycle, Args...>, std::tuple<Args...>, ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>> {
+	private:
+		using traits_t = op_detail::preallocated_traits_t<Smart, Pointer, Recycle, Args...>;
+		using list_t   = ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>;
+		using core_t   = op_detail::base_out_ptr_impl<Smart, Pointer, traits_t, std::tuple<Args...>, list_t>;
+
+		static_assert(sizeof...(Args) > 0, "preallocated_out_ptr requires a deleter to be stored in the preallocated control block");
+
+	public:
+		// the control block is allocated here, rather than in the (noexcept) base,
+		// so an allocation failure is reported before the C function is ever called
+		preallocated_out_ptr_t(Smart& s, Args... args)
+		: core_t(s, std::forward_as_tuple(std::forward<Args>(args)...), traits_t::construct(s, args...)) {
+		}
+	};
+
+	template <typename Smart, typename Pointer, typename... Args>
+	class ZTD_OUT_PTR_TRIVIAL_ABI_I_ recycling_inout_ptr_t
+	: public op_detail::base_out_ptr_impl<Smart, Pointer, op_detail::recycling_inout_traits_t<Smart, Pointer, Args...>, std::tuple<Args...>, ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>> {
+	private:
+		using traits_t = op_detail::recycling_inout_traits_t<Smart, Pointer, Args...>;
+		using list_t   = ztd::out_ptr::op_detail::make_index_sequence<sizeof...(Args)>;
+		using core_t   = op_detail::base_out_ptr_impl<Smart, Pointer, traits_t, std::tuple<Args...>, list_t>;
+
+		static_assert(sizeof...(Args) > 0, "recycling_inout_ptr requires a deleter to be stored in the control block it makes for an empty handle");
+
+		friend struct op_detail::invoke_access;
+
+		// the call failed: anything other than the input it left in place is adopted, as with inout_ptr
+		void abandon() noexcept {
+			if (this->m_smart_ptr != nullptr && traits_t::unchanged(this->m_target_ptr)) {
+				core_t::abandon();
+			}
+			else {
+				core_t::commit();
+			}
+		}
+
+	public:
+		recycling_inout_ptr_t(Smart& s, Args... args)
+		: core_t(s, std::forward_as_tuple(std::forward<Args>(args)...), traits_t::construct(s, args...)) {
+		}
+	};
+
+	namespace op_detail {
+		template <typename Pointer, typename Smart, typename... Args>
+		recycling_inout_ptr_t<Smart, Pointer, Args...> recycling_inout_ptr_tagged(std::false_type, Smart& s, Args&&... args) {
+			using P = recycling_inout_ptr_t<Smart, Pointer, Args...>;
+			return P(s, std::forward<Args>(args)...);
+		}
+
+		template <typename, typename Smart, typename... Args>
+		recycling_inout_ptr_t<Smart, pointer_of_t<Smart>, Args...> recycling_inout_ptr_tagged(std::true_type, Smart& s, Args&&... args) {
+			using Pointer = pointer_of_t<Smart>;
+			using P	    = recycling_inout_ptr_t<Smart, Pointer, Args...>;
+			return P(s, std::forward<Args>(args)...);
+		}
+
+		template <typename Pointer, bool Recycle, typename Smart, typename... Args>
+		preallocated_out_ptr_t<Smart, Pointer, Recycle, Args...> preallocated_out_ptr_tagged(std::false_type, Smart& s, Args&&... args) {
+			using P = preallocated_out_ptr_t<Smart, Pointer, Recycle, Args...>;
+			return P(s, std::forward<Args>(args)...);
+		}
+
+		template <typename, bool Recycle, typename Smart, typename... Args>
+		preallocated_out_ptr_t<Smart, pointer_of_t<Smart>, Recycle, Args...> preallocated_out_ptr_tagged(std::true_type, Smart& s, Args&&... args) {
+			using Pointer = pointer_of_t<Smart>;
+			using P	    = preallocated_out_ptr_t<Smart, Pointer, Recycle, Args...>;
+			return P(s, std::forward<Args>(args)...);
+		}
+
+	} // namespace op_detail
+
+	template <typename Pointer = op_detail::marker, typename Smart, typename... Args>
+	auto preallocated_out_ptr(Smart& s, Args&&... args)
+		-> decltype(op_detail::preallocated_out_ptr_tagged<Pointer, false>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Args>(args)...)) {
+		return op_detail::preallocated_out_ptr_tagged<Pointer, false>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Args>(args)...);
+	}
+
+	// Only safe when no weak_ptr is observing the handle:
+	// a recycled control block keeps the same identity across calls
+	template <typename Pointer = op_detail::marker, typename Smart, typename... Args>
+	auto recycling_out_ptr(Smart& s, Args&&... args)
+		-> decltype(op_detail::preallocated_out_ptr_tagged<Pointer, true>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Args>(args)...)) {
+		return op_detail::preallocated_out_ptr_tagged<Pointer, true>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Args>(args)...);
+	}
+
+	// inout_ptr for a shared_ptr filled by the functions above: the C function is given s's
+	// object only when s is its one owner, and the control block is kept. The same weak_ptr
+	// caveat applies
+	template <typename Pointer = op_detail::marker, typename Smart, typename... Args>
+	auto recycling_inout_ptr(Smart& s, Args&&... args)
+		-> decltype(op_detail::recycling_inout_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Args>(args)...)) {
+		return op_detail::recycling_inout_ptr_tagged<Pointer>(::std::is_same<Pointer, op_detail::marker>(), s, std::forward<Args>(args)...);
+	}
+
+	// whether recycling_inout_ptr(s, Deleter{...}) can be made, rather than throwing:
+	// s is empty, or is the one owner of a control block made by the functions above
+	template <typename Deleter, typename Smart>
+	bool can_recycle_inout(const Smart& s) noexcept {
+		return recycling_inout_ptr_traits<Smart, pointer_of_t<Smart>, Deleter>::accepts(s);
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,284 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_SHARED_HANDLE_HPP
+#define ZTD_OUT_PTR_SHARED_HANDLE_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/static_deleter.hpp>
+#include <ztd/out_ptr/thread_pooled_allocator.hpp>
+#include <ztd/out_ptr/detail/out_ptr_traits.hpp>
+#include <ztd/out_ptr/detail/inout_ptr_traits.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ztd { namespace out_ptr {
+
+	// Counts which any thread may add to or drop, like std::shared_ptr's.
+	struct atomic_count {
+		using count_type = std::atomic<std::size_t>;
+
+		static void add_ref(count_type& count) noexcept {
+			count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// whether that was the last reference
+		static bool release(count_type& count) noexcept {
+			return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+
+		// a count of 1 read here means every other owner is done with the object
+		static std::size_t use_count(const count_type& count) noexcept {
+			return count.load(std::memory_order_acquire);
+		}
+	};
+
+	// Plain counts, for handles whose owners all live on the same thread.
+	struct local_count {
+		using count_type = std::size_t;
+
+		static void add_ref(count_type& count) noexcept {
+			++count;
+		}
+
+		static bool release(count_type& count) noexcept {
+			return --count == 0;
+		}
+
+		static std::size_t use_count(const count_type& count) noexcept {
+			return count;
+		}
+	};
+
+	// A shared owner for C handles, destroyed with a function fixed at compile time: two
+	// pointers, one to the object and one to its count. Unlike std::shared_ptr, there is no
+	// control block holding a type-erased deleter or a weak count, and the count comes from
+	// the calling thread's pool (see thread_pooled_allocator) rather than the global allocator.
+	template <typename T, typename F, F Destroy, typename CountPolicy = atomic_count>
+	class basic_shared_handle {
+	public:
+		using element_type = T;
+		using pointer	  = T*;
+		using count_policy = CountPolicy;
+
+	private:
+		using count_type = typename CountPolicy::count_type;
+
+		template <typename Smart, typename Pointer>
+		friend class inout_ptr_traits;
+
+		pointer m_ptr;
+		// null exactly when m_ptr is
+		count_type* m_count;
+
+		static count_type* make_count() {
+			static_assert(sizeof(count_type) <= op_detail::pool_granule && alignof(count_type) <= op_detail::pool_granule,
+				"a count must fit in one of the pool's smallest blocks");
+			return ::new (op_detail::pool_allocate(sizeof(count_type))) count_type(1);
+		}
+
+		static void free_count(count_type* count) noexcept {
+			count->~count_type();
+			op_detail::pool_deallocate(static_cast<void*>(count), sizeof(count_type));
+		}
+
+		// the object was taken over by a C function, which wrote p in its place
+		void reseat(pointer p) noexcept {
+			if (p == nullptr) {
+				free_count(this->m_count);
+				this->m_count = nullptr;
+			}
+			this->m_ptr = p;
+		}
+
+	public:
+		basic_shared_handle() noexcept : m_ptr(nullptr), m_count(nullptr) {
+		}
+
+		basic_shared_handle(std::nullptr_t) noexcept : basic_shared_handle() {
+		}
+
+		// p is destroyed if its count cannot be allocated
+		explicit basic_shared_handle(pointer p) : m_ptr(p), m_count(nullptr) {
+			if (p != nullptr) {
+				std::unique_ptr<T, basic_static_deleter<F, Destroy>> guard(p);
+				this->m_count = make_count();
+				guard.release();
+			}
+		}
+
+		basic_shared_handle(const basic_shared_handle& right) noexcept : m_ptr(right.m_ptr), m_count(right.m_count) {
+			if (this->m_count != nullptr) {
+				CountPolicy::add_ref(*this->m_count);
+			}
+		}
+
+		basic_shared_handle(basic_shared_handle&& right) noexcept : m_ptr(right.m_ptr), m_count(right.m_count) {
+			right.m_ptr	= nullptr;
+			right.m_count = nullptr;
+		}
+
+		basic_shared_handle& operator=(const basic_shared_handle& right) noexcept {
+			basic_shared_handle(right).swap(*this);
+			return *this;
+		}
+
+		basic_shared_handle& operator=(basic_shared_handle&& right) noexcept {
+			basic_shared_handle(std::move(right)).swap(*this);
+			return *this;
+		}
+
+		~basic_shared_handle() {
+			if (this->m_count != nullptr && CountPolicy::release(*this->m_count)) {
+				free_count(this->m_count);
+				(void)Destroy(this->m_ptr);
+			}
+		}
+
+		void reset() noexcept {
+			basic_shared_handle().swap(*this);
+		}
+
+		// the only owner keeps its count for p, rather than allocating a new one
+		void reset(pointer p) {
+			if (p != nullptr && this->m_count != nullptr && CountPolicy::use_count(*this->m_count) == 1) {
+				pointer old = this->m_ptr;
+				this->m_ptr = p;
+				(void)Destroy(old);
+				return;
+			}
+			basic_shared_handle(p).swap(*this);
+		}
+
+		void swap(basic_shared_handle& right) noexcept {
+			std::swap(this->m_ptr, right.m_ptr);
+			std::swap(this->m_count, right.m_count);
+		}
+
+		pointer get() const noexcept {
+			return this->m_ptr;
+		}
+
+		typename std::add_lvalue_reference<T>::type operator*() const noexcept {
+			return *this->m_ptr;
+		}
+
+		pointer operator->() const noexcept {
+			return this->m_ptr;
+		}
+
+		explicit operator bool() const noexcept {
+			return this->m_ptr != nullptr;
+		}
+
+		std::size_t use_count() const noexcept {
+			return this->m_count == nullptr ? 0 : CountPolicy::use_count(*this->m_count);
+		}
+
+		friend bool operator==(const basic_shared_handle& left, const basic_shared_handle& right) noexcept {
+			return left.m_ptr == right.m_ptr;
+		}
+
+		friend bool operator!=(const basic_shared_handle& left, const basic_shared_handle& right) noexcept {
+			return left.m_ptr != right.m_ptr;
+		}
+	};
+
+#if ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_
+	template <typename T, auto Destroy, typename CountPolicy = atomic_count>
+	using shared_handle = basic_shared_handle<T, decltype(Destroy), Destroy, CountPolicy>;
+#endif // auto template parameters
+
+	template <typename T, typename F, F Destroy, typename CountPolicy, typename Pointer>
+	class out_ptr_traits<basic_shared_handle<T, F, Destroy, CountPolicy>, Pointer> {
+	private:
+		using smart_t		  = basic_shared_handle<T, F, Destroy, CountPolicy>;
+		using source_pointer = typename smart_t::pointer;
+
+	public:
+		using pointer = Pointer;
+
+		static pointer construct(smart_t&) noexcept {
+			return pointer();
+		}
+
+		static typename std::add_pointer<pointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p);
+		}
+
+		static void reset(smart_t& s, pointer& p) {
+			s.reset(static_cast<source_pointer>(p));
+		}
+	};
+
+	namespace op_detail {
+		template <typename Pointer>
+		struct shared_handle_inout_storage {
+			Pointer target;
+			// what the C function was given: the object, or null if others share it
+			Pointer input;
+		};
+	} // namespace op_detail
+
+	// The C function is given the object only when the handle is its one owner, and the handle
+	// is then pointed at the output without a new count. An empty handle gives the C function
+	// null. A handle shared with others is rejected before the call, as with recycling_inout_ptr.
+	template <typename T, typename F, F Destroy, typename CountPolicy, typename Pointer>
+	class inout_ptr_traits<basic_shared_handle<T, F, Destroy, CountPolicy>, Pointer> {
+	private:
+		using smart_t		  = basic_shared_handle<T, F, Destroy, CountPolicy>;
+		using source_pointer = typename smart_t::pointer;
+
+	public:
+		using pointer = op_detail::shared_handle_inout_storage<Pointer>;
+
+		static pointer construct(smart_t& s) {
+			if (s.use_count() > 1) {
+				throw std::invalid_argument("inout_ptr: the shared_handle has other owners, which would be left with the object the C function frees");
+			}
+			Pointer input = static_cast<Pointer>(s.get());
+			return pointer { input, input };
+		}
+
+		static typename std::add_pointer<Pointer>::type get(smart_t&, pointer& p) noexcept {
+			return std::addressof(p.target);
+		}
+
+		static bool unchanged(const pointer& p) noexcept {
+			return p.target == p.input;
+		}
+
+		static void reset(smart_t& s, pointer& p) {
+			if (p.input != Pointer()) {
+				s.reseat(static_cast<source_pointer>(p.target));
+				return;
+			}
+			s.reset(static_cast<source_pointer>(p.target));
+		}
+	};
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#pragma once
+
+#ifndef ZTD_OUT_PTR_STATIC_DELETER_HPP
+#define ZTD_OUT_PTR_STATIC_DELETER_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <ztd/out_ptr/detail/customization_forward.hpp>
+
+#include <memory>
+#include <type_traits>
+
+namespace ztd { namespace out_ptr {
+
+	// Calls a destroy function fixed at compile time, e.g. sqlite3_close.
+	// Unlike a function pointer deleter it is empty, so the handle is exactly
+	// the size of its pointer, and the call is direct rather than indirect.
+	template <typename F, F Destroy>
+	struct basic_static_deleter {
+		template <typename Pointer>
+		void operator()(Pointer p) const {
+			(void)Destroy(p);
+		}
+	};
+
+	template <typename T, typename F, F Destroy>
+	using basic_c_handle = std::unique_ptr<T, basic_static_deleter<F, Destroy>>;
+
+#if ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_
+	template <auto Destroy>
+	using static_deleter = basic_static_deleter<decltype(Destroy), Destroy>;
+
+	template <typename T, auto Destroy>
+	using c_handle = std::unique_ptr<T, static_deleter<Destroy>>;
+#endif // auto template parameters
+
+	// An empty deleter which only destroys the pointer it is given: a unique_ptr
+	// using it is nulled before the C function is called and written into
+	// directly by out_ptr.
+	// Specialize this for other deleters with the same shape.
+	template <typename D>
+	struct is_static_deleter : std::false_type {};
+
+	template <typename F, F Destroy>
+	struct is_static_deleter<basic_static_deleter<F, Destroy>> : std::true_type {};
+
+	namespace op_detail {
+		template <typename Smart>
+		struct is_static_deleter_handle : std::false_type {};
+
+		template <typename T, typename D>
+		struct is_static_deleter_handle<std::unique_ptr<T, D>> : is_static_deleter<D> {};
+
+		template <typename T, typename D>
+		struct is_static_deleter_handle<boost::movelib::unique_ptr<T, D>> : is_static_deleter<D> {};
+	} // namespace op_detail
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -0,0 +1,156 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#pragma once
+
+#ifndef ZTD_OUT_PTR_THREAD_POOLED_ALLOCATOR_HPP
+#define ZTD_OUT_PTR_THREAD_POOLED_ALLOCATOR_HPP
+
+#include <ztd/out_ptr/version.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace ztd { namespace out_ptr {
+
+	namespace op_detail {
+		// control blocks for a pointer + deleter + allocator are a handful of words:
+		// anything bigger (or over-aligned) goes straight to the global allocator
+		constexpr const std::size_t pool_granule		   = alignof(std::max_align_t);
+		constexpr const std::size_t pool_size_classes	   = 8;
+		constexpr const std::size_t pool_max_cached_blocks = 64;
+
+		struct pool_free_node {
+			pool_free_node* next;
+		};
+
+		// trivially destructible on purpose: it stays usable while the
+		// thread's other thread_local objects are being torn down
+		struct thread_pool_state {
+			pool_free_node* heads[pool_size_classes];
+			std::size_t counts[pool_size_classes];
+			bool drained;
+		};
+
+		inline thread_pool_state& this_thread_pool_state() noexcept {
+			static thread_local thread_pool_state state = {};
+			return state;
+		}
+
+		struct thread_pool_drainer {
+			~thread_pool_drainer() {
+				thread_pool_state& state = this_thread_pool_state();
+				state.drained		    = true;
+				for (std::size_t size_class = 0; size_class < pool_size_classes; ++size_class) {
+					pool_free_node* node = state.heads[size_class];
+					while (node != nullptr) {
+						pool_free_node* next = node->next;
+						::operator delete(static_cast<void*>(node));
+						node = next;
+					}
+					state.heads[size_class]  = nullptr;
+					state.counts[size_class] = 0;
+				}
+			}
+		};
+
+		inline thread_pool_state& this_thread_pool() noexcept {
+			// registers the drainer the first time this thread touches its pool
+			static thread_local thread_pool_drainer drainer;
+			(void)drainer;
+			return this_thread_pool_state();
+		}
+
+		inline constexpr std::size_t pool_size_class(std::size_t bytes) noexcept {
+			return (bytes + pool_granule - 1) / pool_granule - 1;
+		}
+
+		inline void* pool_allocate(std::size_t bytes) {
+			std::size_t size_class = pool_size_class(bytes);
+			thread_pool_state& state = this_thread_pool();
+			pool_free_node* node	 = state.heads[size_class];
+			if (node != nullptr) {
+				state.heads[size_class] = node->next;
+				--state.counts[size_class];
+				return static_cast<void*>(node);
+			}
+			return ::operator new((size_class + 1) * pool_granule);
+		}
+
+		inline void pool_deallocate(void* p, std::size_t bytes) noexcept {
+			std::size_t size_class = pool_size_class(bytes);
+			thread_pool_state& state = this_thread_pool_state();
+			if (state.drained || state.counts[size_class] >= pool_max_cached_blocks) {
+				::operator delete(p);
+				return;
+			}
+			// blocks go to the freeing thread's list: every cached block came from
+			// ::operator new, so no thread ever needs to hand one back to its origin
+			this_thread_pool();
+			state.heads[size_class] = ::new (p) pool_free_node { state.heads[size_class] };
+			++state.counts[size_class];
+		}
+	} // namespace op_detail
+
+	template <typename T>
+	class thread_pooled_allocator {
+	public:
+		using value_type						   = T;
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal					   = std::true_type;
+
+		thread_pooled_allocator() noexcept = default;
+
+		template <typename U>
+		thread_pooled_allocator(const thread_pooled_allocator<U>&) noexcept {
+		}
+
+		T* allocate(std::size_t n) {
+			if (!is_pooled(n)) {
+				return std::allocator<T>().allocate(n);
+			}
+			return static_cast<T*>(op_detail::pool_allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept {
+			if (!is_pooled(n)) {
+				std::allocator<T>().deallocate(p, n);
+				return;
+			}
+			op_detail::pool_deallocate(static_cast<void*>(p), n * sizeof(T));
+		}
+
+	private:
+		static bool is_pooled(std::size_t n) noexcept {
+			return alignof(T) <= op_detail::pool_granule && n != 0 && n <= (op_detail::pool_granule * op_detail::pool_size_classes) / sizeof(T);
+		}
+	};
+
+	template <typename T, typename U>
+	bool operator==(const thread_pooled_allocator<T>&, const thread_pooled_allocator<U>&) noexcept {
+		return true;
+	}
+
+	template <typename T, typename U>
+	bool operator!=(const thread_pooled_allocator<T>&, const thread_pooled_allocator<U>&) noexcept {
+		return false;
+	}
+
+}} // namespace ztd::out_ptr
+
+#endif
@@ -17,6 +17,29 @@
 #ifndef ZTD_OUT_PTR_VERSION_HPP
 #define ZTD_OUT_PTR_VERSION_HPP
 
+// any standard header brings in the standard library's own version macros,
+// which the detection below depends on
+#include <cstddef>
+
+// __GLIBC__ is the C library: libstdc++ is __GLIBCXX__
+#if defined(_LIBCPP_VERSION)
+#define ZTD_OUT_PTR_STDLIB_I_ 2
+#elif defined(__GLIBCXX__)
+#define ZTD_OUT_PTR_STDLIB_I_ 1
+#elif defined(_YVALS) || defined(_CPPLIB_VER)
+#define ZTD_OUT_PTR_STDLIB_I_ 3
+#else
+#define ZTD_OUT_PTR_STDLIB_I_ 0
+#endif
+
+// generated by the CMake configure step, if it could run the layout probe
+#if defined(ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE) && (ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE != 0)
+#include <ztd/out_ptr/detail/unique_layout_probe.hpp>
+#define ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_ 1
+#else
+#define ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_ 0
+#endif
+
 #if defined(ZTD_OUT_PTR_CLEVER_SANITY_CHECK)
 #if (ZTD_OUT_PTR_CLEVER_SANITY_CHECK != 0)
 #define ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_ 1
@@ -43,12 +66,84 @@
 #else
 #define ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR_I_ 0
 #endif
-#elif defined(_LIBCPP_VERSION) || defined(__GLIBC__) || defined(_YVALS) || defined(_CPPLIB_VER)
+#elif ZTD_OUT_PTR_STDLIB_I_ != 0
 #define ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR_I_ 1
 #else
 #define ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR_I_ 0
 #endif
 
+// The clever out_ptr paths below empty the handle when the adaptor is constructed, rather than
+// after the call: an intrusive handle is nulled (its reference is only released after the call),
+// an integral handle is set to its empty value, and a unique_ptr with a static deleter is nulled.
+// A C function which leaves its output alone on failure then leaves the handle empty, but the
+// handle's old value can no longer be read in the same call, e.g. derive(h.get(), out_ptr(h)).
+// The intrusive one keeps the old object alive for the call, so p->f(out_ptr(p, false)) is
+// fine: it is on by default. The others must be opted into, or reached through an explicit
+// ownership policy
+#if defined(ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR)
+#if (ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR != 0)
+#define ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ 1
+#else
+#define ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ 0
+#endif
+#else
+#define ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ 1
+#endif
+
+#if defined(ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR)
+#if (ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR != 0)
+#define ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ 1
+#else
+#define ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ 0
+#endif
+#else
+#define ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ 0
+#endif
+
+#if defined(ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR)
+#if (ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR != 0)
+#define ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ 1
+#else
+#define ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ 0
+#endif
+#else
+#define ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ 0
+#endif
+
+#if defined(__cpp_nontype_template_parameter_auto) && (__cpp_nontype_template_parameter_auto >= 201606L)
+#define ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_ 1
+#else
+#define ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_ 0
+#endif
+
+#if defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define ZTD_OUT_PTR_HAS_COROUTINES_I_ 1
+#else
+#define ZTD_OUT_PTR_HAS_COROUTINES_I_ 0
+#endif
+#else
+#define ZTD_OUT_PTR_HAS_COROUTINES_I_ 0
+#endif
+
+// library feature macros live in <version> (or in <memory> itself, before C++20)
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+#if defined(__cpp_lib_atomic_shared_ptr) && (__cpp_lib_atomic_shared_ptr >= 201711L)
+#define ZTD_OUT_PTR_HAS_ATOMIC_SHARED_PTR_I_ 1
+#else
+#define ZTD_OUT_PTR_HAS_ATOMIC_SHARED_PTR_I_ 0
+#endif
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define ZTD_OUT_PTR_HAS_GUARANTEED_COPY_ELISION_I_ 1
+#else
+#define ZTD_OUT_PTR_HAS_GUARANTEED_COPY_ELISION_I_ 0
+#endif
 
 #if defined(ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER)
 #if (ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER != 0)
@@ -56,12 +151,34 @@
 #else
 #define ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 0
 #endif
-#elif defined(_LIBCPP_VERSION)
+#elif ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_
+#if (ZTD_OUT_PTR_PROBED_UNIQUE_STATEFUL_OFFSET == 0)
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 1
+#else
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 0
+#endif
+#elif ZTD_OUT_PTR_STDLIB_I_ == 2
 #define ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 1
 #else
 #define ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 0
 #endif
 
+#if defined(ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER)
+#if (ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER != 0)
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ 1
+#else
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ 0
+#endif
+#elif ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_
+#if (ZTD_OUT_PTR_PROBED_UNIQUE_REFERENCE_OFFSET == 0)
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ 1
+#else
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ 0
+#endif
+#else
+#define ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_
+#endif
+
 #if defined(ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER)
 #if (ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER != 0)
 #define ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 1
@@ -72,6 +189,13 @@
 #define ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ 0
 #endif
 
+// MSVC only applies the empty base optimization to the first empty base, unless asked to
+#if defined(_MSC_VER)
+#define ZTD_OUT_PTR_EMPTY_BASES_I_ __declspec(empty_bases)
+#else
+#define ZTD_OUT_PTR_EMPTY_BASES_I_
+#endif
+
 // Only defined for clang version 7 and above
 #if defined(ZTD_OUT_PTR_TRIVIAL_ABI)
 #define ZTD_OUT_PTR_TRIVIAL_ABI_I_ ZTD_OUT_PTR_TRIVIAL_ABI
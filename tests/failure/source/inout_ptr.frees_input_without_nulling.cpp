@@ -0,0 +1,32 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <catch2/catch_all.hpp>
+
+
+TEST_CASE("inout_ptr/failure/frees_input_without_nulling outside of invoke", "inout_ptr given frees_input_without_nulling will static assert when passed to the C function directly") {
+	SECTION("frees_input_without_nulling without invoke") {
+		std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		ficapi_int_re_create(ztd::out_ptr::inout_ptr(p, ztd::out_ptr::frees_input_without_nulling));
+		REQUIRE(p != nullptr);
+	}
+}
@@ -19,6 +19,8 @@
 #ifndef ZTD_OUT_PTR_TESTS_C_API_HPP
 #define ZTD_OUT_PTR_TESTS_C_API_HPP
 
+#include <ficapi/ficapi.hpp>
+
 #include <cstddef>
 #include <tuple>
 
@@ -90,6 +92,31 @@ namespace ztd { namespace out_ptr { namespace test {
 		return target == derived1 {};
 	}
 
+	// deletes a ficapi int, counting each deletion in *store, and each null pointer
+	// it is handed (as shared_ptr does) in *null_store; either may be left out
+	struct counting_int_deleter {
+		int* store;
+		int* null_store;
+
+		counting_int_deleter() noexcept : store(nullptr), null_store(nullptr) {
+		}
+		counting_int_deleter(int* store_, int* null_store_ = nullptr) noexcept : store(store_), null_store(null_store_) {
+		}
+
+		void operator()(int* x) const {
+			if (x == nullptr) {
+				if (null_store != nullptr) {
+					++*null_store;
+				}
+				return;
+			}
+			if (store != nullptr) {
+				++*store;
+			}
+			ficapi_int_delete(x);
+		}
+	};
+
 }}} // namespace ztd::out_ptr::test
 
 #endif
@@ -0,0 +1,62 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+
+namespace {
+	struct two_pointers {
+		void* smart;
+		void* target;
+	};
+} // namespace
+
+TEST_CASE("adaptor_size/compressed", "stateless arguments are stored by value and take no space") {
+	using deleter_t = ficapi::int_deleter;
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::out_ptr_t<std::shared_ptr<int>, int*, deleter_t>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::out_ptr_t<std::shared_ptr<int>, int*, deleter_t&>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::out_ptr_t<std::shared_ptr<int>, int*, const deleter_t&>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::out_ptr_t<std::unique_ptr<int, deleter_t>, int*, deleter_t&>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::op_detail::simple_out_ptr_t<std::unique_ptr<int>, int*>) == sizeof(two_pointers));
+
+	SECTION("lvalue stateless deleter") {
+		deleter_t deleter;
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, deleter));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+	}
+	SECTION("lvalue stateful deleter is still referenced") {
+		ficapi::stateful_int_deleter deleter { 0x12345678 };
+		STATIC_REQUIRE(sizeof(ztd::out_ptr::out_ptr_t<std::shared_ptr<int>, int*, ficapi::stateful_int_deleter&>) > sizeof(two_pointers));
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, deleter));
+		REQUIRE(p != nullptr);
+		REQUIRE(std::get_deleter<ficapi::stateful_int_deleter>(p)->state() == 0x12345678);
+	}
+}
+
+TEST_CASE("adaptor_size/clever", "the clever adaptors are two words at most") {
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::op_detail::clever_out_ptr_t<std::unique_ptr<int>, int*>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::op_detail::prenull_out_ptr_t<std::unique_ptr<int>, int*>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::op_detail::clever_out_ptr_t<std::unique_ptr<int, ficapi::int_deleter>, void*>) == sizeof(two_pointers));
+	STATIC_REQUIRE(sizeof(ztd::out_ptr::inout_ptr_t<std::unique_ptr<int>, int*>) <= sizeof(two_pointers));
+}
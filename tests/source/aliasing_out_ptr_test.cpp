@@ -0,0 +1,134 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/aliasing_out_ptr.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+
+namespace {
+	struct statement {
+		int index;
+	};
+
+	struct connection {
+		statement statements[2];
+	};
+
+	int connections_closed = 0;
+
+	void connection_close(connection* c) {
+		++connections_closed;
+		delete c;
+	}
+
+	std::shared_ptr<connection> connection_open() {
+		return std::shared_ptr<connection>(new connection { { { 0 }, { 1 } } }, connection_close);
+	}
+
+	// hands out a statement the connection owns, or null for one it does not have
+	int connection_statement(connection* c, int index, statement** out) {
+		if (index < 0 || index > 1) {
+			*out = nullptr;
+			return -1;
+		}
+		*out = &c->statements[index];
+		return 0;
+	}
+
+	bool is_ok(int err) {
+		return err == 0;
+	}
+
+	template <typename Left, typename Right>
+	bool same_control_block(const Left& left, const Right& right) {
+		return !left.owner_before(right) && !right.owner_before(left);
+	}
+} // namespace
+
+TEST_CASE("aliasing_out_ptr/basic", "aliasing_out_ptr shares the owner's control block with the sub-object it commits") {
+	connections_closed = 0;
+	{
+		std::shared_ptr<statement> s;
+		{
+			std::shared_ptr<connection> c = connection_open();
+			connection_statement(c.get(), 1, ztd::out_ptr::aliasing_out_ptr(s, c));
+			REQUIRE(s.get() == &c->statements[1]);
+			REQUIRE(s->index == 1);
+			REQUIRE(same_control_block(s, c));
+			REQUIRE(c.use_count() == 2);
+		}
+		// the statement keeps its connection alive
+		REQUIRE(connections_closed == 0);
+		REQUIRE(s->index == 1);
+	}
+	REQUIRE(connections_closed == 1);
+}
+
+TEST_CASE("aliasing_out_ptr/rvalue owner", "aliasing_out_ptr takes over an rvalue owner's reference") {
+	connections_closed = 0;
+	{
+		std::shared_ptr<connection> c = connection_open();
+		connection* rawc			   = c.get();
+		std::shared_ptr<statement> s;
+		connection_statement(rawc, 0, ztd::out_ptr::aliasing_out_ptr(s, std::move(c)));
+		REQUIRE(s.get() == &rawc->statements[0]);
+		REQUIRE(s.use_count() == 1);
+	}
+	REQUIRE(connections_closed == 1);
+}
+
+TEST_CASE("aliasing_out_ptr/void", "aliasing_out_ptr can write through a pointer type other than the handle's") {
+	connections_closed = 0;
+	{
+		std::shared_ptr<connection> c = connection_open();
+		std::shared_ptr<void> view;
+		connection_statement(c.get(), 0, ztd::out_ptr::aliasing_out_ptr<statement*>(view, c));
+		REQUIRE(view.get() == static_cast<void*>(&c->statements[0]));
+		REQUIRE(same_control_block(view, c));
+	}
+	REQUIRE(connections_closed == 1);
+}
+
+TEST_CASE("aliasing_out_ptr/null", "a null sub-object is committed as an empty handle, which does not keep the owner alive") {
+	connections_closed = 0;
+	std::shared_ptr<connection> c = connection_open();
+	std::shared_ptr<statement> s;
+	connection_statement(c.get(), 0, ztd::out_ptr::aliasing_out_ptr(s, c));
+	REQUIRE(c.use_count() == 2);
+	REQUIRE(connection_statement(c.get(), 5, ztd::out_ptr::aliasing_out_ptr(s, c)) != 0);
+	REQUIRE(s == nullptr);
+	REQUIRE(s.use_count() == 0);
+	REQUIRE(c.use_count() == 1);
+	c.reset();
+	REQUIRE(connections_closed == 1);
+}
+
+TEST_CASE("aliasing_out_ptr/invoke", "a failed call leaves the handle as it was") {
+	connections_closed = 0;
+	{
+		std::shared_ptr<connection> c = connection_open();
+		std::shared_ptr<statement> s;
+		REQUIRE(ztd::out_ptr::invoke(connection_statement, is_ok, c.get(), 1, ztd::out_ptr::aliasing_out_ptr(s, c)) == 0);
+		REQUIRE(s->index == 1);
+		REQUIRE(ztd::out_ptr::invoke(connection_statement, is_ok, c.get(), 5, ztd::out_ptr::aliasing_out_ptr(s, c)) != 0);
+		REQUIRE(s.get() == &c->statements[1]);
+		REQUIRE(c.use_count() == 2);
+	}
+	REQUIRE(connections_closed == 1);
+}
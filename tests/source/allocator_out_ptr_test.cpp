@@ -0,0 +1,203 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+#include <ztd/out_ptr/thread_pooled_allocator.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <cstddef>
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>) && ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L)
+#include <memory_resource>
+#define ZTD_OUT_PTR_TESTS_PMR 1
+#endif
+#endif
+
+namespace {
+	struct allocation_counts {
+		std::size_t allocations   = 0;
+		std::size_t deallocations = 0;
+	};
+
+	template <typename T>
+	struct counting_allocator {
+		using value_type = T;
+
+		allocation_counts* counts;
+
+		counting_allocator(allocation_counts& c) noexcept : counts(&c) {
+		}
+
+		template <typename U>
+		counting_allocator(const counting_allocator<U>& other) noexcept : counts(other.counts) {
+		}
+
+		T* allocate(std::size_t n) {
+			++counts->allocations;
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept {
+			++counts->deallocations;
+			std::allocator<T>().deallocate(p, n);
+		}
+	};
+
+	template <typename T, typename U>
+	bool operator==(const counting_allocator<T>& left, const counting_allocator<U>& right) noexcept {
+		return left.counts == right.counts;
+	}
+
+	template <typename T, typename U>
+	bool operator!=(const counting_allocator<T>& left, const counting_allocator<U>& right) noexcept {
+		return left.counts != right.counts;
+	}
+
+#if defined(ZTD_OUT_PTR_TESTS_PMR)
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		allocation_counts counts;
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			++counts.allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+			++counts.deallocations;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+#endif
+} // namespace
+
+TEST_CASE("out_ptr/allocator", "out_ptr forwards an allocator through to the shared_ptr control block") {
+	SECTION("shared_ptr<int>") {
+		allocation_counts counts;
+		{
+			std::shared_ptr<int> p(nullptr);
+			ficapi_int_create(ztd::out_ptr::out_ptr(p, ficapi::int_deleter(), counting_allocator<int>(counts)));
+			int* rawp = p.get();
+			REQUIRE(rawp != nullptr);
+			REQUIRE(*rawp == ficapi_get_dynamic_data());
+			REQUIRE(counts.allocations == 1);
+			REQUIRE(counts.deallocations == 0);
+			ficapi_int_create(ztd::out_ptr::out_ptr(p, ficapi::int_deleter(), counting_allocator<int>(counts)));
+			REQUIRE(counts.allocations == 2);
+			REQUIRE(counts.deallocations == 1);
+		}
+		REQUIRE(counts.deallocations == 2);
+	}
+	SECTION("shared_ptr<ficapi::opaque>, void out_ptr, stored allocator") {
+		allocation_counts counts;
+		counting_allocator<void> alloc(counts);
+		{
+			std::shared_ptr<ficapi::opaque> p(nullptr);
+			ficapi_create(ztd::out_ptr::out_ptr<void*>(p, ficapi::handle_deleter(), alloc), ficapi_type::ficapi_type_opaque);
+			ficapi::opaque_handle rawp = p.get();
+			REQUIRE(rawp != nullptr);
+			REQUIRE(ficapi_handle_get_data(rawp) == ficapi_get_dynamic_data());
+			REQUIRE(counts.allocations == 1);
+		}
+		REQUIRE(counts.deallocations == 1);
+	}
+	SECTION("preallocated_out_ptr, shared_ptr<int>") {
+		allocation_counts counts;
+		{
+			std::shared_ptr<int> p(nullptr);
+			ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::int_deleter(), counting_allocator<int>(counts)));
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(counts.allocations == 1);
+		}
+		REQUIRE(counts.deallocations == 1);
+	}
+	SECTION("failure") {
+		allocation_counts counts;
+		{
+			std::shared_ptr<int> p(nullptr);
+			int err = ficapi_int_create_fail(ztd::out_ptr::out_ptr(p, ficapi::int_deleter(), counting_allocator<int>(counts)), 1);
+			REQUIRE(err != 0);
+			REQUIRE(p == nullptr);
+			REQUIRE(p.use_count() == 0);
+		}
+		// a null result leaves the shared_ptr empty: no control block is made for it
+		REQUIRE(counts.allocations == 0);
+		REQUIRE(counts.deallocations == 0);
+	}
+}
+
+#if defined(ZTD_OUT_PTR_TESTS_PMR)
+TEST_CASE("out_ptr/allocator/pmr", "out_ptr takes a std::pmr::polymorphic_allocator for the shared_ptr control block") {
+	counting_resource resource;
+	{
+		std::shared_ptr<int> p(nullptr);
+		std::pmr::polymorphic_allocator<std::byte> alloc(&resource);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, ficapi::int_deleter(), alloc));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(resource.counts.allocations == 1);
+		ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::int_deleter(), alloc));
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(resource.counts.allocations == 2);
+		REQUIRE(resource.counts.deallocations == 1);
+	}
+	REQUIRE(resource.counts.deallocations == 2);
+}
+#endif
+
+TEST_CASE("thread_pooled_allocator/reuse", "thread_pooled_allocator hands freed control blocks back out on the same thread") {
+	ztd::out_ptr::thread_pooled_allocator<int> alloc;
+	SECTION("raw") {
+		int* first = alloc.allocate(1);
+		alloc.deallocate(first, 1);
+		int* second = alloc.allocate(1);
+		REQUIRE(second == first);
+		alloc.deallocate(second, 1);
+		// too large for the pool: served (and released) by std::allocator
+		int* large = alloc.allocate(1024);
+		REQUIRE(large != nullptr);
+		alloc.deallocate(large, 1024);
+	}
+	SECTION("shared_ptr<int>") {
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, ficapi::int_deleter(), alloc));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		std::weak_ptr<int> before = p;
+		p.reset();
+		REQUIRE(before.expired());
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, ficapi::int_deleter(), alloc));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+	}
+	SECTION("rebind") {
+		ztd::out_ptr::thread_pooled_allocator<double> rebound(alloc);
+		REQUIRE(rebound == alloc);
+		REQUIRE_FALSE(rebound != alloc);
+	}
+}
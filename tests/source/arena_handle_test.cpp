@@ -0,0 +1,224 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/arena_handle.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+	struct blob {
+		int generation;
+	};
+
+	int blobs_created		  = 0;
+	int blobs_destroyed	  = 0;
+	int batch_destroy_calls = 0;
+
+	void blob_create(blob** out) {
+		++blobs_created;
+		*out = new blob { 0 };
+	}
+
+	// re-initializes in place, or moves to a new object when asked to
+	void blob_re_create(blob** inout, bool move) {
+		if (*inout == nullptr) {
+			blob_create(inout);
+			return;
+		}
+		if (move) {
+			blob* moved = new blob { (*inout)->generation + 1 };
+			delete *inout;
+			*inout = moved;
+			return;
+		}
+		(*inout)->generation += 1;
+	}
+
+	// frees its input and writes null, like a failing realloc-style call which cleans up
+	void blob_re_create_fail(blob** inout) {
+		++blobs_destroyed;
+		delete *inout;
+		*inout = nullptr;
+	}
+
+	void blob_adopt(blob** out, blob* b) {
+		*out = b;
+	}
+
+	void blob_destroy_many(blob** first, std::size_t n) {
+		++batch_destroy_calls;
+		for (std::size_t i = 0; i < n; ++i) {
+			REQUIRE(first[i] != nullptr);
+			++blobs_destroyed;
+			delete first[i];
+		}
+	}
+
+	int ids_deleted = 0;
+
+	void id_create(int* out) {
+		static int next_id = 0;
+		*out			   = ++next_id;
+	}
+
+	void id_delete_many(const int* ids, std::size_t n) {
+		for (std::size_t i = 0; i < n; ++i) {
+			REQUIRE(ids[i] != 0);
+			++ids_deleted;
+		}
+	}
+
+	using blob_arena  = ztd::out_ptr::handle_arena<blob*, ztd::out_ptr::basic_batch_destroy<decltype(&blob_destroy_many), &blob_destroy_many>>;
+	using blob_handle = ztd::out_ptr::arena_handle<blob_arena>;
+
+	void reset_blobs() {
+		blobs_created		  = 0;
+		blobs_destroyed	  = 0;
+		batch_destroy_calls = 0;
+	}
+} // namespace
+
+TEST_CASE("arena_handle/out_ptr", "out_ptr commits into the arena, which destroys everything in one call") {
+	reset_blobs();
+	{
+		blob_arena arena;
+		arena.reserve(100);
+		std::vector<blob_handle> handles;
+		for (int i = 0; i < 100; ++i) {
+			blob_handle h(arena);
+			blob_create(ztd::out_ptr::out_ptr(h));
+			REQUIRE(h);
+			REQUIRE(h->generation == 0);
+			handles.push_back(std::move(h));
+		}
+		REQUIRE(arena.size() == 100);
+		handles.clear();
+		REQUIRE(blobs_destroyed == 0);
+	}
+	REQUIRE(blobs_created == 100);
+	REQUIRE(blobs_destroyed == 100);
+	REQUIRE(batch_destroy_calls == 1);
+}
+
+TEST_CASE("arena_handle/out_ptr overwrite", "out_ptr into a full handle leaves the old object to the arena") {
+	reset_blobs();
+	blob_arena arena;
+	blob_handle h(arena);
+	blob_create(ztd::out_ptr::out_ptr(h));
+	blob* first = h.get();
+	blob_create(ztd::out_ptr::out_ptr(h));
+	REQUIRE(h.get() != first);
+	REQUIRE(arena.size() == 2);
+	REQUIRE(blobs_destroyed == 0);
+	arena.release();
+	REQUIRE(blobs_destroyed == 2);
+	REQUIRE(batch_destroy_calls == 1);
+	REQUIRE(arena.size() == 0);
+	arena.release();
+	REQUIRE(batch_destroy_calls == 1);
+}
+
+TEST_CASE("arena_handle/inout_ptr", "inout_ptr replaces the arena's record instead of adding one") {
+	reset_blobs();
+	{
+		blob_arena arena;
+		blob_handle h(arena);
+		blob_re_create(ztd::out_ptr::inout_ptr(h), false);
+		REQUIRE(arena.size() == 1);
+		blob_re_create(ztd::out_ptr::inout_ptr(h), false);
+		REQUIRE(h->generation == 1);
+		blob_re_create(ztd::out_ptr::inout_ptr(h), true);
+		REQUIRE(h->generation == 2);
+		REQUIRE(arena.size() == 1);
+
+		blob_handle other(arena);
+		blob_create(ztd::out_ptr::out_ptr(other));
+		REQUIRE(arena.size() == 2);
+		blob_re_create_fail(ztd::out_ptr::inout_ptr(other));
+		REQUIRE(!other);
+		REQUIRE(arena.size() == 1);
+		REQUIRE(blobs_destroyed == 1);
+	}
+	REQUIRE(blobs_created == 2);
+	REQUIRE(blobs_destroyed == 2);
+	REQUIRE(batch_destroy_calls == 1);
+}
+
+TEST_CASE("arena_handle/recorded before the call", "the arena's record is made before the C function is called, so committing it cannot fail") {
+	using out_t	 = decltype(ztd::out_ptr::out_ptr(std::declval<blob_handle&>()));
+	using inout_t = decltype(ztd::out_ptr::inout_ptr(std::declval<blob_handle&>()));
+	STATIC_REQUIRE(std::is_nothrow_destructible<out_t>::value);
+	STATIC_REQUIRE(std::is_nothrow_destructible<inout_t>::value);
+	STATIC_REQUIRE_FALSE(std::is_nothrow_constructible<out_t, blob_handle&>::value);
+
+	reset_blobs();
+	{
+		blob_arena arena;
+		blob_handle h(arena);
+		auto write_null = [](blob** out) { *out = nullptr; };
+		write_null(ztd::out_ptr::out_ptr(h));
+		REQUIRE(!h);
+		REQUIRE(arena.size() == 0);
+		write_null(ztd::out_ptr::inout_ptr(h));
+		REQUIRE(!h);
+		REQUIRE(arena.size() == 0);
+		blob_create(ztd::out_ptr::out_ptr(h));
+		REQUIRE(h);
+		REQUIRE(arena.size() == 1);
+		blob_handle other(arena);
+		blob_re_create(ztd::out_ptr::inout_ptr(other), false);
+		REQUIRE(other);
+		REQUIRE(arena.size() == 2);
+	}
+	// the unused records were never handed to the batch destroy function
+	REQUIRE(blobs_created == 2);
+	REQUIRE(blobs_destroyed == 2);
+	REQUIRE(batch_destroy_calls == 1);
+}
+
+TEST_CASE("arena_handle/no_batch_destroy", "an arena over bulk-freed memory only forgets its objects") {
+	blob storage[4] = {};
+	{
+		ztd::out_ptr::handle_arena<blob*, ztd::out_ptr::no_batch_destroy> arena;
+		for (int i = 0; i < 4; ++i) {
+			ztd::out_ptr::arena_handle<ztd::out_ptr::handle_arena<blob*, ztd::out_ptr::no_batch_destroy>> h(arena);
+			blob_adopt(ztd::out_ptr::out_ptr(h), &storage[i]);
+			REQUIRE(h.get() == &storage[i]);
+		}
+		REQUIRE(arena.size() == 4);
+	}
+}
+
+TEST_CASE("arena_handle/integral", "an arena of integer handles, like GL names") {
+	using id_arena = ztd::out_ptr::handle_arena<int, ztd::out_ptr::basic_batch_destroy<decltype(&id_delete_many), &id_delete_many>>;
+	ids_deleted	   = 0;
+	{
+		id_arena arena;
+		ztd::out_ptr::arena_handle<id_arena> a(arena);
+		ztd::out_ptr::arena_handle<id_arena> b(arena);
+		id_create(ztd::out_ptr::out_ptr(a));
+		id_create(ztd::out_ptr::out_ptr(b));
+		REQUIRE(a.get() != 0);
+		REQUIRE(b.get() != a.get());
+		REQUIRE(arena.size() == 2);
+	}
+	REQUIRE(ids_deleted == 2);
+}
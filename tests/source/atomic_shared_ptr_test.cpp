@@ -0,0 +1,66 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/atomic_shared_ptr.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <memory>
+
+#if ZTD_OUT_PTR_HAS_ATOMIC_SHARED_PTR_I_
+namespace {
+	struct gadget {
+		int value;
+	};
+
+	std::atomic<int> gadgets_destroyed(0);
+
+	struct gadget_deleter {
+		void operator()(gadget* g) const noexcept {
+			gadgets_destroyed.fetch_add(1, std::memory_order_relaxed);
+			delete g;
+		}
+	};
+
+	void gadget_create(gadget** out, int value) {
+		*out = new gadget { value };
+	}
+} // namespace
+
+TEST_CASE("atomic_shared_ptr/out_ptr", "out_ptr publishes into a std::atomic<std::shared_ptr>") {
+	gadgets_destroyed = 0;
+	{
+		std::atomic<std::shared_ptr<gadget>> published;
+		gadget_create(ztd::out_ptr::out_ptr(published, gadget_deleter()), 1);
+		std::shared_ptr<gadget> reader = published.load();
+		REQUIRE(reader->value == 1);
+		gadget_create(ztd::out_ptr::out_ptr(published, gadget_deleter()), 2);
+		REQUIRE(published.load()->value == 2);
+		// the reader still owns the first one
+		REQUIRE(gadgets_destroyed == 0);
+		reader.reset();
+		REQUIRE(gadgets_destroyed == 1);
+
+		gadget* nothing = nullptr;
+		auto write_null = [&nothing](gadget** out) { *out = nothing; };
+		write_null(ztd::out_ptr::out_ptr(published, gadget_deleter()));
+		REQUIRE(published.load() == nullptr);
+		REQUIRE(gadgets_destroyed == 2);
+	}
+	REQUIRE(gadgets_destroyed == 2);
+}
+#endif
@@ -0,0 +1,181 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/batch_out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+	// stand-ins for "create_many(size_t n, T** out_array)"-style C functions
+	int ficapi_int_create_many(std::size_t n, int** out_array, int fail) {
+		if (fail != 0) {
+			return 1;
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			ficapi_int_create(out_array + i);
+		}
+		return 0;
+	}
+
+	void ficapi_handle_create_many(std::size_t n, ficapi::opaque_handle* out_array) {
+		for (std::size_t i = 0; i < n; ++i) {
+			ficapi_handle_create(out_array + i);
+		}
+	}
+
+	void ficapi_create_many(std::size_t n, void** out_array, ficapi_type type) {
+		for (std::size_t i = 0; i < n; ++i) {
+			ficapi_create(out_array + i, type);
+		}
+	}
+} // namespace
+
+TEST_CASE("batch_out_ptr/basic", "batch_out_ptr commits a whole array of C outputs into a range of smart pointers") {
+	SECTION("vector<unique_ptr<int>>") {
+		std::vector<std::unique_ptr<int, ficapi::int_deleter>> handles;
+		int err = ficapi_int_create_many(16, ztd::out_ptr::batch_out_ptr(handles, 16), 0);
+		REQUIRE(err == 0);
+		REQUIRE(handles.size() == 16);
+		for (const auto& p : handles) {
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+		}
+	}
+	SECTION("vector<unique_ptr<ficapi::opaque>>") {
+		std::vector<std::unique_ptr<ficapi::opaque, ficapi::handle_deleter>> handles;
+		ficapi_handle_create_many(8, ztd::out_ptr::batch_out_ptr(handles, 8));
+		REQUIRE(handles.size() == 8);
+		for (const auto& p : handles) {
+			REQUIRE(p != nullptr);
+			REQUIRE(ficapi_handle_get_data(p.get()) == ficapi_get_dynamic_data());
+		}
+	}
+	SECTION("vector<unique_ptr<ficapi::opaque>>, void batch_out_ptr") {
+		std::vector<std::unique_ptr<ficapi::opaque, ficapi::handle_deleter>> handles;
+		ficapi_create_many(8, ztd::out_ptr::batch_out_ptr<void*>(handles, 8), ficapi_type::ficapi_type_opaque);
+		REQUIRE(handles.size() == 8);
+		for (const auto& p : handles) {
+			REQUIRE(p != nullptr);
+			REQUIRE(ficapi_handle_get_data(p.get()) == ficapi_get_dynamic_data());
+		}
+	}
+	SECTION("vector<shared_ptr<int>>") {
+		std::vector<std::shared_ptr<int>> handles;
+		int err = ficapi_int_create_many(4, ztd::out_ptr::batch_out_ptr(handles, 4, ficapi::int_deleter()), 0);
+		REQUIRE(err == 0);
+		REQUIRE(handles.size() == 4);
+		for (const auto& p : handles) {
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(std::get_deleter<ficapi::int_deleter>(p) != nullptr);
+		}
+	}
+	SECTION("array<unique_ptr<int>>") {
+		std::array<std::unique_ptr<int, ficapi::int_deleter>, 4> handles {};
+		int err = ficapi_int_create_many(3, ztd::out_ptr::batch_out_ptr(handles, 3), 0);
+		REQUIRE(err == 0);
+		REQUIRE(handles[0] != nullptr);
+		REQUIRE(handles[1] != nullptr);
+		REQUIRE(handles[2] != nullptr);
+		REQUIRE(handles[3] == nullptr);
+	}
+	SECTION("vector<unique_ptr<int>>, more outputs than the inline scratch buffer holds") {
+		std::vector<std::unique_ptr<int, ficapi::int_deleter>> handles;
+		int err = ficapi_int_create_many(100, ztd::out_ptr::batch_out_ptr(handles, 100), 0);
+		REQUIRE(err == 0);
+		REQUIRE(handles.size() == 100);
+		for (const auto& p : handles) {
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+		}
+	}
+	SECTION("empty batch") {
+		std::vector<std::unique_ptr<int, ficapi::int_deleter>> handles;
+		int err = ficapi_int_create_many(0, ztd::out_ptr::batch_out_ptr(handles, 0), 0);
+		REQUIRE(err == 0);
+		REQUIRE(handles.empty());
+	}
+}
+
+TEST_CASE("batch_out_ptr/reused", "batch_out_ptr properly deletes the handles already held by the range") {
+	struct reused_int_deleter {
+		int* store;
+
+		void operator()(int* x) {
+			++*store;
+			ficapi_int_delete(x);
+		}
+	};
+	int deletions = 0;
+	{
+		std::vector<std::unique_ptr<int, reused_int_deleter>> handles;
+		handles.reserve(4);
+		for (int i = 0; i < 4; ++i) {
+			handles.emplace_back(nullptr, reused_int_deleter { &deletions });
+		}
+		int err = ficapi_int_create_many(4, ztd::out_ptr::batch_out_ptr(handles, 4), 0);
+		REQUIRE(err == 0);
+		REQUIRE(deletions == 0);
+		err = ficapi_int_create_many(4, ztd::out_ptr::batch_out_ptr(handles, 4), 0);
+		REQUIRE(err == 0);
+		REQUIRE(deletions == 4);
+		for (const auto& p : handles) {
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+		}
+	}
+	REQUIRE(deletions == 8);
+}
+
+TEST_CASE("batch_out_ptr/failure", "batch_out_ptr leaves every element empty when the C function does not write any outputs") {
+	std::vector<std::unique_ptr<int, ficapi::int_deleter>> handles;
+	int err = ficapi_int_create_many(8, ztd::out_ptr::batch_out_ptr(handles, 8), 1);
+	REQUIRE(err == 1);
+	REQUIRE(handles.size() == 8);
+	for (const auto& p : handles) {
+		REQUIRE(p == nullptr);
+	}
+}
+
+TEST_CASE("batch_out_ptr/too many", "batch_out_ptr refuses more outputs than a fixed-size range holds, before the C function is called") {
+	SECTION("array<unique_ptr<int>>") {
+		std::array<std::unique_ptr<int, ficapi::int_deleter>, 4> handles {};
+		bool called = false;
+		auto create_many = [&called](std::size_t n, int** out_array) {
+			called = true;
+			return ficapi_int_create_many(n, out_array, 0);
+		};
+		REQUIRE_THROWS_AS(create_many(5, ztd::out_ptr::batch_out_ptr(handles, 5)), std::length_error);
+		REQUIRE_FALSE(called);
+		for (const auto& p : handles) {
+			REQUIRE(p == nullptr);
+		}
+	}
+	SECTION("C array of unique_ptr<int>") {
+		std::unique_ptr<int, ficapi::int_deleter> handles[2];
+		REQUIRE_THROWS_AS(ficapi_int_create_many(3, ztd::out_ptr::batch_out_ptr(handles, 3), 0), std::length_error);
+		REQUIRE(handles[0] == nullptr);
+		REQUIRE(handles[1] == nullptr);
+	}
+}
@@ -0,0 +1,205 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/deferred_out_ptr.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+#include <coroutine>
+#endif
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	using completion_t = void (*)(void* user, int err);
+
+	// stands in for a libuv-style C API: the output is taken at submission,
+	// written from a worker thread, and the completion callback runs there too
+	std::thread async_int_create(int** out, int fail, completion_t done, void* user) {
+		return std::thread([=]() {
+			std::this_thread::yield();
+			if (fail != 0) {
+				done(user, -1);
+				return;
+			}
+			ficapi_int_create(out);
+			done(user, 0);
+		});
+	}
+
+	template <typename Deferred>
+	void on_completion(void* user, int err) {
+		Deferred& op = *static_cast<Deferred*>(user);
+		if (err == 0) {
+			op.complete();
+		}
+		else {
+			op.abandon();
+		}
+	}
+} // namespace
+
+TEST_CASE("deferred_out_ptr/wait", "deferred_out_ptr commits when the asynchronous call completes") {
+	SECTION("unique_ptr, success") {
+		int deleted = 0;
+		using handle_t = std::unique_ptr<int, counting_int_deleter>;
+		handle_t p(nullptr, counting_int_deleter(&deleted));
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int* old = p.get();
+		using deferred_t = ztd::out_ptr::deferred_out_ptr_t<handle_t>;
+		deferred_t op(p);
+		std::thread worker = async_int_create(op, 0, &on_completion<deferred_t>, &op);
+		handle_t& result	= op.wait();
+		REQUIRE(op.ready());
+		REQUIRE(&result == &p);
+		REQUIRE(p != nullptr);
+		REQUIRE(p.get() != old);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(deleted == 1);
+		worker.join();
+	}
+	SECTION("unique_ptr, failure") {
+		int deleted = 0;
+		using handle_t = std::unique_ptr<int, counting_int_deleter>;
+		handle_t p(nullptr, counting_int_deleter(&deleted));
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int* old = p.get();
+		using deferred_t = ztd::out_ptr::deferred_out_ptr_t<handle_t>;
+		deferred_t op(p);
+		std::thread worker = async_int_create(op.get(), 1, &on_completion<deferred_t>, &op);
+		op.wait();
+		REQUIRE(p.get() == old);
+		REQUIRE(deleted == 0);
+		worker.join();
+	}
+	SECTION("unique_ptr, destroyed without completing") {
+		int deleted = 0;
+		using handle_t = std::unique_ptr<int, counting_int_deleter>;
+		handle_t p(nullptr, counting_int_deleter(&deleted));
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int* old     = p.get();
+		int* written = new int(24);
+		{
+			ztd::out_ptr::deferred_out_ptr_t<handle_t> op(p);
+			*op.get() = written;
+			// the output lives in op: the smart pointer is untouched until completion
+			REQUIRE(p.get() == old);
+		}
+		REQUIRE(p.get() == old);
+		REQUIRE(deleted == 0);
+		delete written;
+	}
+	SECTION("shared_ptr, with a deleter kept until completion") {
+		int deleted = 0;
+		std::shared_ptr<int> p(nullptr);
+		using deferred_t = ztd::out_ptr::deferred_out_ptr_t<std::shared_ptr<int>, int*, counting_int_deleter>;
+		std::thread worker;
+		{
+			deferred_t op(p, counting_int_deleter(&deleted));
+			worker = async_int_create(op, 0, &on_completion<deferred_t>, &op);
+			op.wait();
+		}
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		worker.join();
+		p.reset();
+		REQUIRE(deleted == 1);
+	}
+#if ZTD_OUT_PTR_HAS_GUARANTEED_COPY_ELISION_I_
+	SECTION("factory") {
+		std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+		auto op		    = ztd::out_ptr::deferred_out_ptr(p);
+		std::thread worker = async_int_create(op, 0, &on_completion<decltype(op)>, &op);
+		REQUIRE(*op.wait() == ficapi_get_dynamic_data());
+		worker.join();
+	}
+#endif
+	SECTION("many in flight") {
+		using handle_t	 = std::unique_ptr<int, ficapi::int_deleter>;
+		using deferred_t = ztd::out_ptr::deferred_out_ptr_t<handle_t>;
+		const std::size_t count = 16;
+		std::vector<handle_t> handles(count);
+		std::vector<std::unique_ptr<deferred_t>> ops;
+		std::vector<std::thread> workers;
+		for (std::size_t i = 0; i < count; ++i) {
+			ops.emplace_back(new deferred_t(handles[i]));
+			workers.push_back(async_int_create(*ops.back(), static_cast<int>(i % 2), &on_completion<deferred_t>, ops.back().get()));
+		}
+		for (std::size_t i = 0; i < count; ++i) {
+			ops[i]->wait();
+			REQUIRE((handles[i] != nullptr) == (i % 2 == 0));
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+}
+
+#if ZTD_OUT_PTR_HAS_COROUTINES_I_
+namespace {
+	struct detached_task {
+		struct promise_type {
+			detached_task get_return_object() noexcept {
+				return {};
+			}
+			std::suspend_never initial_suspend() noexcept {
+				return {};
+			}
+			std::suspend_never final_suspend() noexcept {
+				return {};
+			}
+			void return_void() noexcept {
+			}
+			void unhandled_exception() noexcept {
+				std::terminate();
+			}
+		};
+	};
+
+	detached_task await_int(std::unique_ptr<int, ficapi::int_deleter>& p, int fail, std::thread& worker, std::atomic<int>& seen) {
+		using deferred_t = ztd::out_ptr::deferred_out_ptr_t<std::unique_ptr<int, ficapi::int_deleter>>;
+		deferred_t op(p);
+		worker = async_int_create(op, fail, &on_completion<deferred_t>, &op);
+		std::unique_ptr<int, ficapi::int_deleter>& result = co_await op;
+		seen.store(result != nullptr ? *result : -1);
+	}
+} // namespace
+
+TEST_CASE("deferred_out_ptr/co_await", "co_await on a deferred_out_ptr resumes with the committed smart pointer") {
+	std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+	std::atomic<int> seen(0);
+	std::thread worker;
+	await_int(p, 0, worker, seen);
+	worker.join();
+	REQUIRE(seen.load() == ficapi_get_dynamic_data());
+	REQUIRE(p != nullptr);
+
+	std::unique_ptr<int, ficapi::int_deleter> q(nullptr);
+	await_int(q, 1, worker, seen);
+	worker.join();
+	REQUIRE(seen.load() == -1);
+	REQUIRE(q == nullptr);
+}
+#endif
@@ -0,0 +1,160 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/epoch_handle.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct settings {
+		int version;
+		int checksum;
+	};
+
+	std::atomic<int> settings_destroyed(0);
+
+	struct settings_deleter {
+		void operator()(settings* s) const noexcept {
+			// scribbled over, so a reader still using it would notice
+			s->checksum = -1;
+			settings_destroyed.fetch_add(1, std::memory_order_relaxed);
+			delete s;
+		}
+	};
+
+	using settings_handle = ztd::out_ptr::epoch_handle<settings, settings_deleter>;
+
+	void settings_create(settings** out) {
+		*out = new settings { 0, 0 };
+	}
+
+	// copy-on-write: a new object derived from the old one, which is left alone
+	void settings_derive(settings** inout) {
+		const settings* old = *inout;
+		int version			= old == nullptr ? 0 : old->version + 1;
+		*inout				= new settings { version, version * 3 };
+	}
+
+	int settings_derive_or_fail(settings** inout, int fail) {
+		if (fail != 0) {
+			return -1;
+		}
+		settings_derive(inout);
+		return 0;
+	}
+} // namespace
+
+TEST_CASE("epoch_handle/out_ptr", "out_ptr publishes, and the replaced object waits for readers") {
+	settings_destroyed = 0;
+	{
+		settings_handle h;
+		settings_create(ztd::out_ptr::out_ptr(h));
+		REQUIRE(h);
+		{
+			ztd::out_ptr::epoch_guard reading;
+			const settings* seen = h.load();
+			settings_create(ztd::out_ptr::out_ptr(h));
+			// still readable: this thread's section started before it was replaced
+			REQUIRE(seen->checksum == 0);
+			REQUIRE(h.retired() == 1);
+			REQUIRE(settings_destroyed == 0);
+		}
+		h.reclaim();
+		REQUIRE(h.retired() == 0);
+		REQUIRE(settings_destroyed == 1);
+	}
+	REQUIRE(settings_destroyed == 2);
+}
+
+TEST_CASE("epoch_handle/inout_ptr", "inout_ptr derives from the published object and retires it") {
+	settings_destroyed = 0;
+	{
+		settings_handle h;
+		settings_derive(ztd::out_ptr::inout_ptr(h));
+		REQUIRE(h.get()->version == 0);
+		for (int i = 0; i < 5; ++i) {
+			settings_derive(ztd::out_ptr::inout_ptr(h));
+		}
+		REQUIRE(h.get()->version == 5);
+		h.reclaim();
+		REQUIRE(h.retired() == 0);
+		REQUIRE(settings_destroyed == 5);
+
+		int result = ztd::out_ptr::invoke(&settings_derive_or_fail, [](int r) { return r == 0; }, ztd::out_ptr::inout_ptr(h), 1);
+		REQUIRE(result == -1);
+		REQUIRE(h.get()->version == 5);
+		REQUIRE(h.retired() == 0);
+	}
+	REQUIRE(settings_destroyed == 6);
+}
+
+TEST_CASE("epoch_handle/nested guards", "sections nest, and only the outermost one ends the read") {
+	settings_destroyed = 0;
+	settings_handle h(new settings { 0, 0 });
+	{
+		ztd::out_ptr::epoch_guard outer;
+		{
+			ztd::out_ptr::epoch_guard inner;
+		}
+		h.reset(new settings { 1, 3 });
+		h.reclaim();
+		REQUIRE(settings_destroyed == 0);
+	}
+	h.reclaim();
+	REQUIRE(settings_destroyed == 1);
+}
+
+TEST_CASE("epoch_handle/readers", "readers never see a destroyed object while a writer keeps re-creating") {
+	settings_destroyed = 0;
+	const int writes   = 2000;
+	const int readers  = 4;
+	{
+		settings_handle h(new settings { 0, 0 });
+		std::atomic<bool> done(false);
+		std::atomic<int> torn(0);
+		std::vector<std::thread> reader_threads;
+		for (int i = 0; i < readers; ++i) {
+			reader_threads.emplace_back([&h, &done, &torn]() {
+				while (!done.load(std::memory_order_acquire)) {
+					ztd::out_ptr::epoch_guard reading;
+					const settings* s = h.load();
+					if (s->checksum != s->version * 3) {
+						torn.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			});
+		}
+		for (int i = 0; i < writes; ++i) {
+			settings_derive(ztd::out_ptr::inout_ptr(h));
+		}
+		done.store(true, std::memory_order_release);
+		for (std::thread& t : reader_threads) {
+			t.join();
+		}
+		REQUIRE(torn == 0);
+		REQUIRE(h.get()->version == writes);
+		h.reclaim();
+		REQUIRE(h.retired() == 0);
+		REQUIRE(settings_destroyed == writes);
+	}
+	REQUIRE(settings_destroyed == writes + 1);
+}
@@ -0,0 +1,238 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/array_out_ptr.hpp>
+
+#include <phd/handle.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+
+namespace {
+	// a tiny, portable stand-in for a file descriptor table
+	struct fake_fd_table {
+		bool open[16];
+		int live;
+	};
+
+	fake_fd_table fds = {};
+
+	int fake_fd_next() {
+		for (int fd = 0; fd < 16; ++fd) {
+			if (!fds.open[fd]) {
+				fds.open[fd] = true;
+				++fds.live;
+				return fd;
+			}
+		}
+		return -1;
+	}
+
+	void fake_fd_close(int fd) {
+		REQUIRE(fd >= 0);
+		REQUIRE(fds.open[fd]);
+		fds.open[fd] = false;
+		--fds.live;
+	}
+
+	int fake_open(int* out) {
+		int fd = fake_fd_next();
+		if (fd < 0) {
+			return -1;
+		}
+		*out = fd;
+		return 0;
+	}
+
+	// like most POSIX calls: the output is left untouched on failure
+	int fake_open_fail(int*) {
+		return -1;
+	}
+
+	int fake_pipe(int out[2]) {
+		out[0] = fake_fd_next();
+		out[1] = fake_fd_next();
+		return 0;
+	}
+
+	int fake_pipe_fail(int*) {
+		return -1;
+	}
+
+	// like dup: opens a new descriptor standing for an open one
+	int fake_dup(int fd, int* out) {
+		if (fd < 0 || !fds.open[fd]) {
+			return -1;
+		}
+		return fake_open(out);
+	}
+
+	// closes the given descriptor and opens a new one in its place
+	int fake_reopen(int* inout) {
+		fake_fd_close(*inout);
+		return fake_open(inout);
+	}
+
+	struct fake_fd_deleter {
+		using pointer = int;
+
+		static void write_null(int& fd) noexcept {
+			fd = -1;
+		}
+
+		static bool is_null(const int& fd) noexcept {
+			return fd < 0;
+		}
+
+		void operator()(int fd) const {
+			fake_fd_close(fd);
+		}
+	};
+
+	using unique_fd = ztd::handle<int, fake_fd_deleter>;
+
+	struct plain_fd {
+		using pointer = int;
+	};
+} // namespace
+
+TEST_CASE("integral_handle/selection", "integral handles are recognized and take the clever paths") {
+	STATIC_REQUIRE(std::is_same<ztd::out_ptr::pointer_of_t<plain_fd>, int>::value);
+	STATIC_REQUIRE(ztd::out_ptr::op_detail::is_integral_handle<unique_fd, int>::value);
+	STATIC_REQUIRE_FALSE(ztd::out_ptr::op_detail::is_integral_handle<ztd::handle<int*, fake_fd_deleter>, int*>::value);
+	STATIC_REQUIRE(std::is_base_of<ztd::out_ptr::op_detail::out_integral_fast<unique_fd, int>, decltype(ztd::out_ptr::out_ptr(std::declval<unique_fd&>(), ztd::out_ptr::null_on_failure))>::value);
+	STATIC_REQUIRE(std::is_base_of<ztd::out_ptr::op_detail::inout_integral_fast<unique_fd, int>, decltype(ztd::out_ptr::inout_ptr(std::declval<unique_fd&>(), ztd::out_ptr::null_on_failure))>::value);
+#if ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_
+	STATIC_REQUIRE(std::is_base_of<ztd::out_ptr::op_detail::out_integral_fast<unique_fd, int>, decltype(ztd::out_ptr::out_ptr(std::declval<unique_fd&>()))>::value);
+	STATIC_REQUIRE(std::is_base_of<ztd::out_ptr::op_detail::array_integral_fast<unique_fd[2], int>, decltype(ztd::out_ptr::array_out_ptr(std::declval<unique_fd(&)[2]>()))>::value);
+#elif !ZTD_OUT_PTR_USE_CLEVER_OUT_PTR_I_
+	// the clever path empties the handle before the call: it is never taken without asking
+	STATIC_REQUIRE_FALSE(std::is_base_of<ztd::out_ptr::op_detail::out_integral_fast<unique_fd, int>, decltype(ztd::out_ptr::out_ptr(std::declval<unique_fd&>()))>::value);
+	STATIC_REQUIRE_FALSE(std::is_base_of<ztd::out_ptr::op_detail::array_integral_fast<unique_fd[2], int>, decltype(ztd::out_ptr::array_out_ptr(std::declval<unique_fd(&)[2]>()))>::value);
+#endif
+}
+
+TEST_CASE("integral_handle/out_ptr", "out_ptr into an integral handle closes the old value exactly once and never adopts a bogus value") {
+	fds = fake_fd_table {};
+	SECTION("default") {
+		{
+			unique_fd fd(nullptr);
+			REQUIRE(fd.get() == -1);
+			REQUIRE(fake_open(ztd::out_ptr::out_ptr(fd)) == 0);
+			REQUIRE(fd.get() == 0);
+			REQUIRE(fake_open(ztd::out_ptr::out_ptr(fd)) == 0);
+			// the new descriptor is opened before the old one is closed
+			REQUIRE(fd.get() == 1);
+			REQUIRE(fds.live == 1);
+			REQUIRE(fake_open_fail(ztd::out_ptr::out_ptr(fd)) != 0);
+			REQUIRE(fd.get() == -1);
+			REQUIRE(fds.live == 0);
+			REQUIRE(fake_open(ztd::out_ptr::out_ptr(fd)) == 0);
+		}
+		REQUIRE(fds.live == 0);
+	}
+#if !ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ && !ZTD_OUT_PTR_USE_CLEVER_OUT_PTR_I_
+	SECTION("default, reading the handle in the same call") {
+		{
+			unique_fd fd(nullptr);
+			REQUIRE(fake_open(ztd::out_ptr::out_ptr(fd)) == 0);
+			REQUIRE(fd.get() == 0);
+			REQUIRE(fake_dup(fd.get(), ztd::out_ptr::out_ptr(fd)) == 0);
+			REQUIRE(fd.get() == 1);
+			REQUIRE(fds.live == 1);
+		}
+		REQUIRE(fds.live == 0);
+	}
+#endif
+	SECTION("simple") {
+		{
+			unique_fd fd(nullptr);
+			REQUIRE(fake_open(ztd::out_ptr::op_detail::simple_out_ptr(fd)) == 0);
+			REQUIRE(fd.get() == 0);
+			REQUIRE(fake_open_fail(ztd::out_ptr::op_detail::simple_out_ptr(fd)) != 0);
+			// not 0: that would be someone else's descriptor
+			REQUIRE(fd.get() == -1);
+			REQUIRE(fds.live == 0);
+			REQUIRE(fake_open(ztd::out_ptr::op_detail::simple_out_ptr(fd)) == 0);
+		}
+		REQUIRE(fds.live == 0);
+	}
+}
+
+TEST_CASE("integral_handle/inout_ptr", "inout_ptr into an integral handle hands the old value over to the C function") {
+	fds = fake_fd_table {};
+	{
+		unique_fd fd(nullptr);
+		REQUIRE(fake_open(ztd::out_ptr::out_ptr(fd)) == 0);
+		REQUIRE(fake_reopen(ztd::out_ptr::inout_ptr(fd)) == 0);
+		REQUIRE(fd.get() == 0);
+		REQUIRE(fds.live == 1);
+		REQUIRE(fake_reopen(ztd::out_ptr::op_detail::simple_inout_ptr(fd)) == 0);
+		REQUIRE(fd.get() == 0);
+		REQUIRE(fds.live == 1);
+	}
+	REQUIRE(fds.live == 0);
+}
+
+TEST_CASE("integral_handle/array_out_ptr", "array_out_ptr commits a fixed number of outputs, as with pipe(int[2])") {
+	fds = fake_fd_table {};
+	SECTION("unique_fd[2]") {
+		{
+			unique_fd ends[2] = { unique_fd(nullptr), unique_fd(nullptr) };
+			REQUIRE(fake_pipe(ztd::out_ptr::array_out_ptr(ends)) == 0);
+			REQUIRE(ends[0].get() == 0);
+			REQUIRE(ends[1].get() == 1);
+			REQUIRE(fake_pipe(ztd::out_ptr::array_out_ptr(ends)) == 0);
+			REQUIRE(ends[0].get() == 2);
+			REQUIRE(ends[1].get() == 3);
+			REQUIRE(fds.live == 2);
+			REQUIRE(fake_pipe_fail(ztd::out_ptr::array_out_ptr(ends)) != 0);
+			REQUIRE(ends[0].get() == -1);
+			REQUIRE(ends[1].get() == -1);
+			REQUIRE(fds.live == 0);
+			REQUIRE(fake_pipe(ztd::out_ptr::array_out_ptr(ends)) == 0);
+		}
+		REQUIRE(fds.live == 0);
+	}
+	SECTION("std::array<unique_fd, 2>") {
+		{
+			std::array<unique_fd, 2> ends = { { unique_fd(nullptr), unique_fd(nullptr) } };
+			REQUIRE(fake_pipe(ztd::out_ptr::array_out_ptr(ends)) == 0);
+			REQUIRE(fake_pipe(ztd::out_ptr::array_out_ptr(ends)) == 0);
+			REQUIRE(fds.live == 2);
+			REQUIRE(fake_pipe_fail(ztd::out_ptr::array_out_ptr(ends)) != 0);
+			REQUIRE(ends[0].get() == -1);
+			REQUIRE(ends[1].get() == -1);
+			REQUIRE(fds.live == 0);
+		}
+		REQUIRE(fds.live == 0);
+	}
+	SECTION("std::array<std::unique_ptr<int>, 2>") {
+		std::array<std::unique_ptr<int>, 2> ints;
+		ints[0].reset(new int(0));
+		int* raw[2] = { new int(1), new int(2) };
+		auto fill = [&raw](int** out) {
+			out[0] = raw[0];
+			out[1] = raw[1];
+			return 0;
+		};
+		REQUIRE(fill(ztd::out_ptr::array_out_ptr(ints)) == 0);
+		REQUIRE(*ints[0] == 1);
+		REQUIRE(*ints[1] == 2);
+	}
+}
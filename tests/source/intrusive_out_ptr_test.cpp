@@ -0,0 +1,253 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__has_include)
+#if __has_include(<boost/intrusive_ptr.hpp>)
+#include <boost/intrusive_ptr.hpp>
+#define ZTD_OUT_PTR_TESTS_BOOST_INTRUSIVE_PTR 1
+#endif
+#endif
+
+namespace {
+	int live_objects = 0;
+
+	// a COM-style object: created with a reference count of 1, handed out through a void**
+	struct refcounted {
+		int refs;
+		int value;
+
+		// like QueryInterface: reads this object while writing a new one, and
+		// records how many objects were alive, this one included, during the call
+		int derive(void** out, int* live_during_call) {
+			*live_during_call = live_objects;
+			++live_objects;
+			*out = new refcounted { 1, this->value + 1 };
+			return 0;
+		}
+	};
+
+	void refcounted_add_ref(refcounted* p) {
+		++p->refs;
+	}
+
+	void refcounted_release(refcounted* p) {
+		if (--p->refs == 0) {
+			--live_objects;
+			delete p;
+		}
+	}
+
+	int refcounted_create(void** out, int value) {
+		++live_objects;
+		*out = new refcounted { 1, value };
+		return 0;
+	}
+
+	int refcounted_create_fail(void**, int) {
+		return -1;
+	}
+
+	int refcounted_create_scribble(void** out, int) {
+		*out = reinterpret_cast<void*>(static_cast<std::uintptr_t>(0xDEAD));
+		return -1;
+	}
+
+	// an in-house handle with the same shape as boost::intrusive_ptr
+	class ref_handle {
+	public:
+		using element_type = refcounted;
+
+		ref_handle() noexcept
+		: m_ptr(nullptr) {
+		}
+		ref_handle(std::nullptr_t) noexcept
+		: m_ptr(nullptr) {
+		}
+		ref_handle(const ref_handle& right) noexcept
+		: m_ptr(right.m_ptr) {
+			if (this->m_ptr != nullptr) {
+				refcounted_add_ref(this->m_ptr);
+			}
+		}
+		ref_handle& operator=(const ref_handle& right) noexcept {
+			ref_handle(right).swap(*this);
+			return *this;
+		}
+		~ref_handle() {
+			if (this->m_ptr != nullptr) {
+				refcounted_release(this->m_ptr);
+			}
+		}
+
+		void reset() noexcept {
+			ref_handle().swap(*this);
+		}
+
+		void reset(refcounted* p, bool add_ref) noexcept {
+			if (add_ref && p != nullptr) {
+				refcounted_add_ref(p);
+			}
+			ref_handle old;
+			old.m_ptr	  = this->m_ptr;
+			this->m_ptr = p;
+		}
+
+		refcounted* get() const noexcept {
+			return this->m_ptr;
+		}
+
+		refcounted* operator->() const noexcept {
+			return this->m_ptr;
+		}
+
+		void swap(ref_handle& right) noexcept {
+			refcounted* p = right.m_ptr;
+			right.m_ptr   = this->m_ptr;
+			this->m_ptr   = p;
+		}
+
+	private:
+		refcounted* m_ptr;
+	};
+
+#if defined(ZTD_OUT_PTR_TESTS_BOOST_INTRUSIVE_PTR)
+	void intrusive_ptr_add_ref(refcounted* p) {
+		refcounted_add_ref(p);
+	}
+
+	void intrusive_ptr_release(refcounted* p) {
+		refcounted_release(p);
+	}
+#endif
+} // namespace
+
+namespace ztd { namespace out_ptr {
+	template <>
+	struct is_intrusive_handle<ref_handle> : std::true_type {};
+}} // namespace ztd::out_ptr
+
+#if defined(ZTD_OUT_PTR_TESTS_BOOST_INTRUSIVE_PTR)
+#define ZTD_OUT_PTR_TESTS_INTRUSIVE_HANDLES ref_handle, boost::intrusive_ptr<refcounted>
+#else
+#define ZTD_OUT_PTR_TESTS_INTRUSIVE_HANDLES ref_handle
+#endif
+
+TEMPLATE_TEST_CASE("intrusive_out_ptr/selection", "out_ptr(handle, add_ref) adopts straight into an intrusive handle", ZTD_OUT_PTR_TESTS_INTRUSIVE_HANDLES) {
+	using fast_t = ztd::out_ptr::op_detail::out_intrusive_fast<TestType, void*>;
+	STATIC_REQUIRE(ztd::out_ptr::is_intrusive_handle<TestType>::value);
+#if ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ || ZTD_OUT_PTR_USE_CLEVER_OUT_PTR_I_
+	STATIC_REQUIRE(std::is_base_of<fast_t, decltype(ztd::out_ptr::out_ptr<void*>(std::declval<TestType&>(), false))>::value);
+	STATIC_REQUIRE(std::is_base_of<fast_t, decltype(ztd::out_ptr::out_ptr<void*>(std::declval<TestType&>(), std::declval<bool&>()))>::value);
+#endif
+	STATIC_REQUIRE(std::is_base_of<fast_t, decltype(ztd::out_ptr::out_ptr<void*>(std::declval<TestType&>(), ztd::out_ptr::null_on_failure, false))>::value);
+	STATIC_REQUIRE_FALSE(std::is_base_of<fast_t, decltype(ztd::out_ptr::out_ptr<void*>(std::declval<TestType&>()))>::value);
+	STATIC_REQUIRE_FALSE(std::is_base_of<fast_t, decltype(ztd::out_ptr::out_ptr<void*>(std::declval<TestType&>(), ztd::out_ptr::frees_input_without_nulling, false))>::value);
+}
+
+TEMPLATE_TEST_CASE("intrusive_out_ptr/adopt", "out_ptr into an intrusive handle takes exactly the references it should", ZTD_OUT_PTR_TESTS_INTRUSIVE_HANDLES) {
+	live_objects = 0;
+	SECTION("adopt, without add_ref") {
+		{
+			TestType p(nullptr);
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, false), 1) == 0);
+			REQUIRE(p.get() != nullptr);
+			REQUIRE(p->refs == 1);
+			REQUIRE(p->value == 1);
+
+			TestType q = p;
+			REQUIRE(p->refs == 2);
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, false), 2) == 0);
+			// the old object is still held by q
+			REQUIRE(live_objects == 2);
+			REQUIRE(q->refs == 1);
+			REQUIRE(p->refs == 1);
+			REQUIRE(p->value == 2);
+
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, false), 3) == 0);
+			REQUIRE(live_objects == 2);
+			REQUIRE(p->value == 3);
+		}
+		REQUIRE(live_objects == 0);
+	}
+	SECTION("with add_ref") {
+		refcounted* rawp = nullptr;
+		{
+			TestType p(nullptr);
+			bool add_ref = true;
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, add_ref), 4) == 0);
+			rawp = p.get();
+			REQUIRE(rawp != nullptr);
+			REQUIRE(rawp->refs == 2);
+		}
+		REQUIRE(live_objects == 1);
+		REQUIRE(rawp->refs == 1);
+		refcounted_release(rawp);
+		REQUIRE(live_objects == 0);
+	}
+	SECTION("failure") {
+		{
+			TestType p(nullptr);
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, false), 5) == 0);
+			REQUIRE(live_objects == 1);
+			REQUIRE(refcounted_create_fail(ztd::out_ptr::out_ptr<void*>(p, false), 6) != 0);
+			// the old reference is given up, and nothing is adopted
+			REQUIRE(p.get() == nullptr);
+			REQUIRE(live_objects == 0);
+			REQUIRE(refcounted_create_fail(ztd::out_ptr::out_ptr<void*>(p, true), 7) != 0);
+			REQUIRE(p.get() == nullptr);
+		}
+		REQUIRE(live_objects == 0);
+	}
+}
+
+TEMPLATE_TEST_CASE("intrusive_out_ptr/self", "out_ptr into an intrusive handle keeps the old object alive for the call", ZTD_OUT_PTR_TESTS_INTRUSIVE_HANDLES) {
+	live_objects = 0;
+	SECTION("p->f(out_ptr(p)) on the last reference") {
+		{
+			TestType p(nullptr);
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, false), 1) == 0);
+			REQUIRE(p->refs == 1);
+			int live_during_call = 0;
+			REQUIRE(p->derive(ztd::out_ptr::out_ptr<void*>(p, false), &live_during_call) == 0);
+			REQUIRE(live_during_call == 1);
+			REQUIRE(live_objects == 1);
+			REQUIRE(p->refs == 1);
+			REQUIRE(p->value == 2);
+		}
+		REQUIRE(live_objects == 0);
+	}
+	SECTION("abandoned through invoke") {
+		{
+			TestType p(nullptr);
+			REQUIRE(refcounted_create(ztd::out_ptr::out_ptr<void*>(p, false), 3) == 0);
+			refcounted* old = p.get();
+			auto is_ok       = [](int err) { return err == 0; };
+			REQUIRE(ztd::out_ptr::invoke(refcounted_create_scribble, is_ok, ztd::out_ptr::out_ptr<void*>(p, false), 4) != 0);
+			// the old reference is put back, over what the C function wrote
+			REQUIRE(p.get() == old);
+			REQUIRE(p->refs == 1);
+			REQUIRE(live_objects == 1);
+		}
+		REQUIRE(live_objects == 0);
+	}
+}
@@ -0,0 +1,180 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/invoke.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	int not_an_int = 0;
+
+	// a sloppy vendor function: on failure, it leaves garbage in its output
+	int create_int_or_scribble(int** out, int fail) {
+		if (fail != 0) {
+			*out = &not_an_int;
+			return -1;
+		}
+		ficapi_int_create(out);
+		return 0;
+	}
+
+	// a re-allocating vendor function which leaves its input alone on failure
+	int re_create_int(int** inout, int fail) {
+		if (fail != 0) {
+			return -1;
+		}
+		ficapi_int_delete(*inout);
+		ficapi_int_create(inout);
+		**inout += 1;
+		return 0;
+	}
+
+	// a re-allocating vendor function which frees its input on failure, but does not null it
+	int re_create_int_freeing(int** inout, int fail) {
+		ficapi_int_delete(*inout);
+		if (fail != 0) {
+			return -1;
+		}
+		ficapi_int_create(inout);
+		return 0;
+	}
+
+	int create_int_or_throw(int** out, int fail) {
+		if (fail != 0) {
+			*out = &not_an_int;
+			throw std::runtime_error("vendor failure");
+		}
+		ficapi_int_create(out);
+		return 0;
+	}
+
+	bool is_ok(int err) {
+		return err == 0;
+	}
+} // namespace
+
+TEST_CASE("invoke/out_ptr", "invoke commits out_ptr outputs only when the predicate accepts the result") {
+	SECTION("unique_ptr, success") {
+		int deleted = 0;
+		std::unique_ptr<int, counting_int_deleter> p(nullptr, counting_int_deleter(&deleted));
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int* old = p.get();
+		// the handle is settled before invoke returns, even within the same expression
+		REQUIRE((ztd::out_ptr::invoke(create_int_or_scribble, is_ok, ztd::out_ptr::out_ptr(p), 0) == 0 && p != nullptr && p.get() != old));
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(deleted == 1);
+	}
+	SECTION("unique_ptr, failure") {
+		int deleted = 0;
+		std::unique_ptr<int, counting_int_deleter> p(nullptr, counting_int_deleter(&deleted));
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int* old = p.get();
+		int err	= ztd::out_ptr::invoke(create_int_or_scribble, is_ok, ztd::out_ptr::out_ptr(p), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p.get() == old);
+		REQUIRE(deleted == 0);
+	}
+	SECTION("unique_ptr, failure, void**") {
+		std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+		int err = ztd::out_ptr::invoke(
+			[](void** out, int fail) { return create_int_or_scribble(static_cast<int**>(static_cast<void*>(out)), fail); }, is_ok,
+			ztd::out_ptr::out_ptr<void*>(p), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p == nullptr);
+	}
+	SECTION("shared_ptr, success and failure") {
+		int deleted = 0;
+		std::shared_ptr<int> p(nullptr);
+		int err = ztd::out_ptr::invoke(create_int_or_scribble, is_ok, ztd::out_ptr::out_ptr(p, counting_int_deleter(&deleted)), 0);
+		REQUIRE(err == 0);
+		REQUIRE(p != nullptr);
+		int* old = p.get();
+		err		= ztd::out_ptr::invoke(create_int_or_scribble, is_ok, ztd::out_ptr::out_ptr(p, counting_int_deleter(&deleted)), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p.get() == old);
+		REQUIRE(deleted == 0);
+		p.reset();
+		REQUIRE(deleted == 1);
+	}
+	SECTION("ownership policy") {
+		std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int* old = p.get();
+		int err	= ztd::out_ptr::invoke(create_int_or_scribble, is_ok, ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p.get() == old);
+		err = ztd::out_ptr::invoke(create_int_or_scribble, is_ok, ztd::out_ptr::out_ptr(p, ztd::out_ptr::null_on_failure), 0);
+		REQUIRE(err == 0);
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+	}
+}
+
+TEST_CASE("invoke/inout_ptr", "invoke commits inout_ptr outputs only when the predicate accepts the result") {
+	SECTION("unique_ptr, success and failure") {
+		std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int err = ztd::out_ptr::invoke(re_create_int, is_ok, ztd::out_ptr::inout_ptr(p), 0);
+		REQUIRE(err == 0);
+		REQUIRE(*p == ficapi_get_dynamic_data() + 1);
+		int* old = p.get();
+		err		= ztd::out_ptr::invoke(re_create_int, is_ok, ztd::out_ptr::inout_ptr(p), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p.get() == old);
+	}
+	SECTION("raw pointer, failure") {
+		int* p = nullptr;
+		ficapi_int_create(&p);
+		int* old = p;
+		int err	= ztd::out_ptr::invoke(re_create_int, is_ok, ztd::out_ptr::inout_ptr(p), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p == old);
+		ficapi_int_delete(p);
+	}
+	SECTION("frees_input_without_nulling") {
+		int deleted = 0;
+		std::unique_ptr<int, counting_int_deleter> p(nullptr, counting_int_deleter(&deleted));
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		int err = ztd::out_ptr::invoke(re_create_int_freeing, is_ok, ztd::out_ptr::inout_ptr(p, ztd::out_ptr::frees_input_without_nulling), 0);
+		REQUIRE(err == 0);
+		REQUIRE(p != nullptr);
+		// the failing call freed the input: it is released, not deleted a second time
+		err = ztd::out_ptr::invoke(re_create_int_freeing, is_ok, ztd::out_ptr::inout_ptr(p, ztd::out_ptr::frees_input_without_nulling), 1);
+		REQUIRE(err == -1);
+		REQUIRE(p == nullptr);
+		REQUIRE(deleted == 0);
+	}
+}
+
+TEST_CASE("invoke/exceptions", "a throwing call is treated as a failure") {
+	int deleted = 0;
+	std::unique_ptr<int, counting_int_deleter> p(nullptr, counting_int_deleter(&deleted));
+	ficapi_int_create(ztd::out_ptr::out_ptr(p));
+	int* old = p.get();
+	REQUIRE_THROWS_AS(ztd::out_ptr::invoke(create_int_or_throw, is_ok, ztd::out_ptr::out_ptr(p), 1), std::runtime_error);
+	REQUIRE(p.get() == old);
+	REQUIRE(deleted == 0);
+}
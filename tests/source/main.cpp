@@ -24,8 +24,13 @@
 int main(int argc, char* argv[]) {
 	std::cout << "ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_ = " << ZTD_OUT_PTR_CLEVER_SANITY_CHECK_I_ << std::endl;
 	std::cout << "ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR_I_ = " << ZTD_OUT_PTR_USE_CLEVER_INOUT_PTR_I_ << std::endl;
+	std::cout << "ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ = " << ZTD_OUT_PTR_USE_CLEVER_INTRUSIVE_OUT_PTR_I_ << std::endl;
+	std::cout << "ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ = " << ZTD_OUT_PTR_USE_CLEVER_INTEGRAL_OUT_PTR_I_ << std::endl;
+	std::cout << "ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ = " << ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ << std::endl;
 	std::cout << "ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ = " << ZTD_OUT_PTR_CLEVER_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ << std::endl;
 	std::cout << "ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ = " << ZTD_OUT_PTR_CLEVER_MOVELIB_UNIQUE_IMPLEMENTATION_FIRST_MEMBER_I_ << std::endl;
+	std::cout << "ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ = " << ZTD_OUT_PTR_CLEVER_UNIQUE_REFERENCE_FIRST_MEMBER_I_ << std::endl;
+	std::cout << "ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_ = " << ZTD_OUT_PTR_HAS_UNIQUE_LAYOUT_PROBE_I_ << std::endl;
 
 	int r = Catch::Session().run(argc, argv);
 	return r;
@@ -0,0 +1,140 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/batch_out_ptr.hpp>
+#include <ztd/out_ptr/lazy_arg.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	// stands in for an expensive deleter: counts how often it is built and called
+	struct deleter_counts {
+		int built = 0;
+		int calls = 0;
+		int nulls = 0;
+	};
+
+	struct make_counting_int_deleter {
+		deleter_counts* counts;
+
+		counting_int_deleter operator()() const {
+			++counts->built;
+			return counting_int_deleter(&counts->calls, &counts->nulls);
+		}
+	};
+
+	int int_create_many(std::size_t n, int** out, std::size_t fail_every) {
+		for (std::size_t i = 0; i < n; ++i) {
+			if (fail_every != 0 && (i % fail_every) == 0) {
+				continue;
+			}
+			ficapi_int_create(out + i);
+		}
+		return 0;
+	}
+} // namespace
+
+TEST_CASE("null_commit/shared_ptr", "a null output leaves a shared_ptr empty, without a control block or a deleter call") {
+	STATIC_REQUIRE(ztd::out_ptr::commits_null_as_empty<std::shared_ptr<int>>::value);
+	STATIC_REQUIRE_FALSE(ztd::out_ptr::commits_null_as_empty<std::unique_ptr<int>>::value);
+	deleter_counts counts;
+	{
+		std::shared_ptr<int> p(nullptr);
+		int err = ficapi_int_create_fail(ztd::out_ptr::out_ptr(p, counting_int_deleter(&counts.calls, &counts.nulls)), 1);
+		REQUIRE(err != 0);
+		REQUIRE(p == nullptr);
+		REQUIRE(p.use_count() == 0);
+	}
+	REQUIRE(counts.calls == 0);
+	{
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, counting_int_deleter(&counts.calls, &counts.nulls)));
+		REQUIRE(p != nullptr);
+		std::weak_ptr<int> old_p = p;
+		int err = ficapi_int_create_fail(ztd::out_ptr::out_ptr(p, counting_int_deleter(&counts.calls, &counts.nulls)), 1);
+		REQUIRE(err != 0);
+		// the old value is still released
+		REQUIRE(p.use_count() == 0);
+		REQUIRE(old_p.expired());
+		REQUIRE(counts.calls == 1);
+	}
+	REQUIRE(counts.calls == 1);
+	REQUIRE(counts.nulls == 0);
+}
+
+TEST_CASE("null_commit/lazy_arg", "a lazy deleter is only built when a non-null value is committed") {
+	SECTION("shared_ptr") {
+		deleter_counts counts;
+		{
+			std::shared_ptr<int> p(nullptr);
+			int err = ficapi_int_create_fail(ztd::out_ptr::out_ptr(p, ztd::out_ptr::lazy_arg(make_counting_int_deleter { &counts })), 1);
+			REQUIRE(err != 0);
+			REQUIRE(p == nullptr);
+			REQUIRE(counts.built == 0);
+
+			ficapi_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::lazy_arg(make_counting_int_deleter { &counts })));
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(counts.built == 1);
+		}
+		REQUIRE(counts.calls == 1);
+	}
+	SECTION("unique_ptr") {
+		deleter_counts counts;
+		{
+			std::unique_ptr<int, counting_int_deleter> p(nullptr, counting_int_deleter(&counts.calls, &counts.nulls));
+			int err = ficapi_int_create_fail(ztd::out_ptr::out_ptr(p, ztd::out_ptr::lazy_arg(make_counting_int_deleter { &counts })), 1);
+			REQUIRE(err != 0);
+			REQUIRE(p == nullptr);
+			REQUIRE(counts.built == 0);
+
+			ficapi_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::lazy_arg(make_counting_int_deleter { &counts })));
+			REQUIRE(p != nullptr);
+			REQUIRE(counts.built == 1);
+
+			ficapi_int_re_create(ztd::out_ptr::inout_ptr(p, ztd::out_ptr::lazy_arg(make_counting_int_deleter { &counts })));
+			REQUIRE(p != nullptr);
+			REQUIRE(counts.built == 2);
+		}
+		REQUIRE(counts.calls == 1);
+	}
+	SECTION("batch_out_ptr") {
+		deleter_counts counts;
+		{
+			std::vector<std::shared_ptr<int>> handles;
+			int_create_many(6, ztd::out_ptr::batch_out_ptr(handles, 6, ztd::out_ptr::lazy_arg(make_counting_int_deleter { &counts })), 3);
+			REQUIRE(handles.size() == 6);
+			REQUIRE(handles[0] == nullptr);
+			REQUIRE(handles[0].use_count() == 0);
+			REQUIRE(handles[1] != nullptr);
+			REQUIRE(handles[3] == nullptr);
+			// built once for every non-null handle committed
+			REQUIRE(counts.built == 4);
+		}
+		REQUIRE(counts.calls == 4);
+		REQUIRE(counts.nulls == 0);
+	}
+}
@@ -0,0 +1,205 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/out_ptrs.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	struct counting_handle_deleter {
+		int* store;
+
+		counting_handle_deleter() noexcept : store(nullptr) {
+		}
+		counting_handle_deleter(int* store_) noexcept : store(store_) {
+		}
+
+		void operator()(ficapi::opaque_handle x) const {
+			if (store != nullptr) {
+				++*store;
+			}
+			ficapi_handle_delete(x);
+		}
+	};
+
+	// a vendor-style call with two owning outputs: either both are written, or, if
+	// only_first is set, only the first one, and the call reports failure
+	int create_pair(int** first, ficapi_opaque_handle* second, int fail, int only_first) {
+		if (fail != 0 && only_first == 0) {
+			return 1;
+		}
+		ficapi_int_create(first);
+		if (fail != 0) {
+			return 1;
+		}
+		ficapi_handle_create(second);
+		return 0;
+	}
+} // namespace
+
+TEST_CASE("out_ptrs/basic", "out_ptrs commits every output of a single call") {
+	SECTION("unique_ptr, unique_ptr") {
+		std::unique_ptr<int, ficapi::int_deleter> a(nullptr);
+		std::unique_ptr<ficapi::opaque, ficapi::handle_deleter> b(nullptr);
+		{
+			auto outs = ztd::out_ptr::out_ptrs(a, b);
+			int err	= create_pair(outs.get<0>(), outs.get<1>(), 0, 0);
+			REQUIRE(err == 0);
+			REQUIRE(a == nullptr);
+		}
+		REQUIRE(a != nullptr);
+		REQUIRE(*a == ficapi_get_dynamic_data());
+		REQUIRE(b != nullptr);
+		REQUIRE(ficapi_handle_get_data(b.get()) == ficapi_get_dynamic_data());
+	}
+	SECTION("shared_ptr through out_arg, unique_ptr") {
+		std::shared_ptr<int> a(nullptr);
+		std::unique_ptr<ficapi::opaque, ficapi::handle_deleter> b(nullptr);
+		{
+			auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::out_arg(a, ficapi::int_deleter()), b);
+			create_pair(outs.get<0>(), outs.get<1>(), 0, 0);
+		}
+		REQUIRE(a != nullptr);
+		REQUIRE(a.use_count() == 1);
+		REQUIRE(*a == ficapi_get_dynamic_data());
+		REQUIRE(b != nullptr);
+	}
+	SECTION("void* output through out_arg") {
+		std::unique_ptr<ficapi::opaque, ficapi::handle_deleter> a(nullptr);
+		std::unique_ptr<ficapi::opaque, ficapi::handle_deleter> b(nullptr);
+		{
+			auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::out_arg<void*>(a), b);
+			ficapi_create(outs.get<0>(), ficapi_type::ficapi_type_opaque);
+			ficapi_handle_create(outs.get<1>());
+		}
+		REQUIRE(a != nullptr);
+		REQUIRE(ficapi_handle_get_data(a.get()) == ficapi_get_dynamic_data());
+		REQUIRE(b != nullptr);
+	}
+}
+
+TEST_CASE("out_ptrs/ownership", "out_ptrs replaces old values and destroys each output exactly once") {
+	int int_deletions	 = 0;
+	int handle_deletions = 0;
+	{
+		std::unique_ptr<int, counting_int_deleter> a(nullptr, counting_int_deleter { &int_deletions });
+		std::shared_ptr<ficapi::opaque> b(nullptr);
+		create_pair(ztd::out_ptr::out_ptrs(a, ztd::out_ptr::out_arg(b, counting_handle_deleter(&handle_deletions))).get<0>(), nullptr, 1, 1);
+		REQUIRE(a != nullptr);
+		REQUIRE(b == nullptr);
+		{
+			auto outs = ztd::out_ptr::out_ptrs(a, ztd::out_ptr::out_arg(b, counting_handle_deleter(&handle_deletions)));
+			create_pair(outs.get<0>(), outs.get<1>(), 0, 0);
+			REQUIRE(int_deletions == 0);
+		}
+		REQUIRE(int_deletions == 1);
+		REQUIRE(handle_deletions == 0);
+		REQUIRE(a != nullptr);
+		REQUIRE(b != nullptr);
+	}
+	REQUIRE(int_deletions == 2);
+	REQUIRE(handle_deletions == 1);
+}
+
+TEST_CASE("out_ptrs/commit_each", "out_ptrs commits whichever outputs were written, and empties the rest") {
+	int handle_deletions = 0;
+	std::unique_ptr<int, ficapi::int_deleter> a(nullptr);
+	std::unique_ptr<ficapi::opaque, counting_handle_deleter> b(nullptr, counting_handle_deleter(&handle_deletions));
+	ficapi_handle_create(ztd::out_ptr::out_ptr(b));
+	REQUIRE(b != nullptr);
+	{
+		auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::commit_each, a, b);
+		int err	= create_pair(outs.get<0>(), outs.get<1>(), 1, 1);
+		REQUIRE(err != 0);
+	}
+	REQUIRE(a != nullptr);
+	REQUIRE(*a == ficapi_get_dynamic_data());
+	REQUIRE(b == nullptr);
+	REQUIRE(handle_deletions == 1);
+}
+
+TEST_CASE("out_ptrs/all_or_nothing", "out_ptrs with all_or_nothing commits either every output or none") {
+	SECTION("every output written") {
+		std::unique_ptr<int, ficapi::int_deleter> a(nullptr);
+		std::shared_ptr<ficapi::opaque> b(nullptr);
+		{
+			auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::all_or_nothing, a, ztd::out_ptr::out_arg(b, ficapi::handle_deleter()));
+			create_pair(outs.get<0>(), outs.get<1>(), 0, 0);
+		}
+		REQUIRE(a != nullptr);
+		REQUIRE(b != nullptr);
+		REQUIRE(ficapi_handle_get_data(b.get()) == ficapi_get_dynamic_data());
+	}
+	SECTION("some outputs written") {
+		int int_deletions	 = 0;
+		int handle_deletions = 0;
+		{
+			std::unique_ptr<int, counting_int_deleter> a(nullptr, counting_int_deleter { &int_deletions });
+			std::unique_ptr<ficapi::opaque, counting_handle_deleter> b(nullptr, counting_handle_deleter(&handle_deletions));
+			ficapi_int_create(ztd::out_ptr::out_ptr(a));
+			ficapi_handle_create(ztd::out_ptr::out_ptr(b));
+			int* old_a					= a.get();
+			ficapi::opaque_handle old_b = b.get();
+			{
+				auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::all_or_nothing, ztd::out_ptr::out_arg(a, counting_int_deleter { &int_deletions }), b);
+				int err	= create_pair(outs.get<0>(), outs.get<1>(), 1, 1);
+				REQUIRE(err != 0);
+			}
+			// the written first output is destroyed, and neither handle is touched
+			REQUIRE(int_deletions == 1);
+			REQUIRE(handle_deletions == 0);
+			REQUIRE(a.get() == old_a);
+			REQUIRE(b.get() == old_b);
+		}
+		REQUIRE(int_deletions == 2);
+		REQUIRE(handle_deletions == 1);
+	}
+	SECTION("nothing written") {
+		std::unique_ptr<int, ficapi::int_deleter> a(nullptr);
+		std::unique_ptr<ficapi::opaque, ficapi::handle_deleter> b(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(a));
+		int* old_a = a.get();
+		{
+			auto outs = ztd::out_ptr::out_ptrs(ztd::out_ptr::all_or_nothing, a, b);
+			create_pair(outs.get<0>(), outs.get<1>(), 1, 0);
+		}
+		REQUIRE(a.get() == old_a);
+		REQUIRE(b == nullptr);
+	}
+}
+
+TEST_CASE("out_ptrs/move", "a moved-from out_ptrs commits nothing") {
+	int int_deletions = 0;
+	std::unique_ptr<int, counting_int_deleter> a(nullptr, counting_int_deleter { &int_deletions });
+	std::unique_ptr<ficapi::opaque, ficapi::handle_deleter> b(nullptr);
+	{
+		auto outs  = ztd::out_ptr::out_ptrs(a, b);
+		auto moved = std::move(outs);
+		create_pair(moved.get<0>(), moved.get<1>(), 0, 0);
+	}
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	REQUIRE(int_deletions == 0);
+}
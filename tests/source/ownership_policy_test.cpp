@@ -0,0 +1,171 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/ownership_policy.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <type_traits>
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	int deletions = 0;
+
+	using counted_int_ptr = std::unique_ptr<int, counting_int_deleter>;
+
+	// writes NULL to the output when it fails
+	int nulling_int_create(int** out, int fail) {
+		if (fail != 0) {
+			*out = nullptr;
+			return 1;
+		}
+		ficapi_int_create(out);
+		return 0;
+	}
+
+	// does not touch the output when it fails
+	int untouched_int_create(int** out, int fail) {
+		if (fail != 0) {
+			return 1;
+		}
+		ficapi_int_create(out);
+		return 0;
+	}
+
+	// frees the input when it fails, but leaves the dangling value in place
+	int consuming_int_re_create(int** inout, int fail) {
+		ficapi_int_delete(*inout);
+		if (fail != 0) {
+			return 1;
+		}
+		ficapi_int_create(inout);
+		return 0;
+	}
+} // namespace
+
+TEST_CASE("ownership_policy/selection", "ownership policies pick the cheapest correct implementation") {
+	using fast_t		= ztd::out_ptr::op_detail::out_unique_fast<counted_int_ptr, int, counting_int_deleter, int*, false>;
+	using prenull_t	= ztd::out_ptr::op_detail::out_unique_fast<counted_int_ptr, int, counting_int_deleter, int*, true>;
+	using inout_fast_t	= ztd::out_ptr::op_detail::inout_unique_fast<counted_int_ptr, int, counting_int_deleter, int*>;
+	using null_out_t	= decltype(ztd::out_ptr::out_ptr(std::declval<counted_int_ptr&>(), ztd::out_ptr::null_on_failure));
+	using unchanged_out_t = decltype(ztd::out_ptr::out_ptr(std::declval<counted_int_ptr&>(), ztd::out_ptr::unchanged_on_failure));
+	using frees_out_t	= decltype(ztd::out_ptr::out_ptr(std::declval<counted_int_ptr&>(), ztd::out_ptr::frees_input_without_nulling));
+	using null_inout_t	= decltype(ztd::out_ptr::inout_ptr(std::declval<counted_int_ptr&>(), ztd::out_ptr::null_on_failure));
+	using frees_inout_t = decltype(ztd::out_ptr::inout_ptr(std::declval<counted_int_ptr&>(), ztd::out_ptr::frees_input_without_nulling));
+	using freeing_inout_t = ztd::out_ptr::op_detail::freeing_inout_ptr_t<counted_int_ptr, int*>;
+	STATIC_REQUIRE(std::is_base_of<fast_t, null_out_t>::value);
+	STATIC_REQUIRE(std::is_base_of<prenull_t, unchanged_out_t>::value);
+	STATIC_REQUIRE_FALSE(std::is_base_of<fast_t, frees_out_t>::value);
+	STATIC_REQUIRE_FALSE(std::is_base_of<prenull_t, frees_out_t>::value);
+	STATIC_REQUIRE(std::is_base_of<inout_fast_t, null_inout_t>::value);
+	STATIC_REQUIRE(std::is_base_of<freeing_inout_t, frees_inout_t>::value);
+}
+
+TEST_CASE("ownership_policy/out_ptr", "out_ptr with an ownership policy releases the old value exactly once, whether or not the C function succeeds") {
+	SECTION("null_on_failure") {
+		deletions = 0;
+		{
+			counted_int_ptr p(nullptr, counting_int_deleter(&deletions));
+			REQUIRE(nulling_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::null_on_failure), 0) == 0);
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(nulling_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::null_on_failure), 1) == 1);
+			REQUIRE(p == nullptr);
+			REQUIRE(deletions == 1);
+		}
+		REQUIRE(deletions == 1);
+	}
+	SECTION("unchanged_on_failure") {
+		deletions = 0;
+		{
+			counted_int_ptr p(nullptr, counting_int_deleter(&deletions));
+			REQUIRE(untouched_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure), 0) == 0);
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(untouched_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure), 1) == 1);
+			REQUIRE(p == nullptr);
+			REQUIRE(deletions == 1);
+			REQUIRE(untouched_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure), 0) == 0);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+		}
+		REQUIRE(deletions == 2);
+	}
+	SECTION("unchanged_on_failure, void*") {
+		std::unique_ptr<int, ficapi::int_deleter> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure));
+		REQUIRE(p != nullptr);
+		int err = ficapi_create_fail(ztd::out_ptr::out_ptr<void*>(p, ztd::out_ptr::unchanged_on_failure), ficapi_type::ficapi_type_int, 1);
+		REQUIRE(err != 0);
+		REQUIRE(p == nullptr);
+	}
+	SECTION("with a deleter argument") {
+		deletions = 0;
+		{
+			std::shared_ptr<int> p(nullptr);
+			REQUIRE(untouched_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::unchanged_on_failure, counting_int_deleter(&deletions)), 0) == 0);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(nulling_int_create(ztd::out_ptr::out_ptr(p, ztd::out_ptr::null_on_failure, counting_int_deleter(&deletions)), 1) == 1);
+			REQUIRE(p == nullptr);
+			REQUIRE(deletions == 1);
+		}
+		REQUIRE(deletions == 1);
+	}
+}
+
+TEST_CASE("ownership_policy/inout_ptr", "inout_ptr with an ownership policy never leaves a freed value in the smart pointer") {
+	SECTION("unchanged_on_failure") {
+		deletions = 0;
+		{
+			counted_int_ptr p(nullptr, counting_int_deleter(&deletions));
+			ficapi_int_create(ztd::out_ptr::out_ptr(p));
+			int* before = p.get();
+			REQUIRE(ficapi_int_re_create_fail(ztd::out_ptr::inout_ptr(p, ztd::out_ptr::unchanged_on_failure), 1) == 1);
+			REQUIRE(p.get() == before);
+			REQUIRE(deletions == 0);
+			REQUIRE(ficapi_int_re_create_fail(ztd::out_ptr::inout_ptr(p, ztd::out_ptr::unchanged_on_failure), 0) == 0);
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(deletions == 0);
+		}
+		REQUIRE(deletions == 1);
+	}
+	SECTION("frees_input_without_nulling") {
+		deletions = 0;
+		{
+			counted_int_ptr p(nullptr, counting_int_deleter(&deletions));
+			ficapi_int_create(ztd::out_ptr::out_ptr(p));
+			auto succeeded = [](int err) { return err == 0; };
+			// the new value may well be at the freed input's address: only the result code tells
+			REQUIRE(ztd::out_ptr::invoke(consuming_int_re_create, succeeded, ztd::out_ptr::inout_ptr(p, ztd::out_ptr::frees_input_without_nulling), 0) == 0);
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(ztd::out_ptr::invoke(consuming_int_re_create, succeeded, ztd::out_ptr::inout_ptr(p, ztd::out_ptr::frees_input_without_nulling), 1) == 1);
+			// the dangling value left behind is not kept
+			REQUIRE(p == nullptr);
+		}
+		// every value was freed by the C function itself
+		REQUIRE(deletions == 0);
+	}
+}
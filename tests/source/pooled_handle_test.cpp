@@ -0,0 +1,133 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/pooled_handle.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct widget {
+		int generation;
+	};
+
+	int widgets_created	  = 0;
+	int widgets_destroyed = 0;
+
+	void widget_destroy(widget* w) {
+		++widgets_destroyed;
+		delete w;
+	}
+
+	void widget_create(widget** out) {
+		++widgets_created;
+		*out = new widget { 0 };
+	}
+
+	// re-initializes an existing object in place, or creates one if given null
+	void widget_re_create(widget** inout) {
+		if (*inout == nullptr) {
+			widget_create(inout);
+			return;
+		}
+		(*inout)->generation += 1;
+	}
+
+	using widget_pool	 = ztd::out_ptr::handle_pool<decltype(&widget_destroy), &widget_destroy, 4>;
+	using widget_handle = ztd::out_ptr::basic_pooled_handle<widget, decltype(&widget_destroy), &widget_destroy, 4>;
+
+	void reset_widgets() {
+		widget_pool::drain();
+		widgets_created	  = 0;
+		widgets_destroyed = 0;
+	}
+} // namespace
+
+TEST_CASE("pooled_handle/inout_ptr", "inout_ptr re-creates into a warm handle from the pool") {
+	reset_widgets();
+	ztd::out_ptr::handle_pool_stats before = widget_pool::stats();
+	for (int i = 0; i < 10; ++i) {
+		widget_handle h(nullptr);
+		widget_re_create(ztd::out_ptr::inout_ptr(h));
+		REQUIRE(h != nullptr);
+		REQUIRE(h->generation == i);
+	}
+	ztd::out_ptr::handle_pool_stats after = widget_pool::stats();
+	REQUIRE(widgets_created == 1);
+	REQUIRE(widgets_destroyed == 0);
+	REQUIRE(after.misses - before.misses == 1);
+	REQUIRE(after.hits - before.hits == 9);
+	REQUIRE(after.recycled - before.recycled == 10);
+	REQUIRE(widget_pool::size() == 1);
+	widget_pool::drain();
+	REQUIRE(widgets_destroyed == 1);
+	REQUIRE(widget_pool::size() == 0);
+}
+
+TEST_CASE("pooled_handle/out_ptr", "out_ptr gives the handle it replaces back to the pool") {
+	reset_widgets();
+	widget_handle h(nullptr);
+	widget_create(ztd::out_ptr::out_ptr(h));
+	widget* first = h.get();
+	widget_create(ztd::out_ptr::out_ptr(h));
+	REQUIRE(h.get() != first);
+	REQUIRE(widgets_destroyed == 0);
+	REQUIRE(widget_pool::size() == 1);
+	h.reset();
+	REQUIRE(widget_pool::size() == 2);
+	widget_handle warm(nullptr);
+	widget_re_create(ztd::out_ptr::inout_ptr(warm));
+	REQUIRE(widgets_created == 2);
+	REQUIRE(warm->generation == 1);
+	warm.reset();
+	widget_pool::drain();
+	REQUIRE(widgets_destroyed == 2);
+}
+
+TEST_CASE("pooled_handle/capacity", "a full pool destroys what it cannot keep") {
+	reset_widgets();
+	{
+		std::vector<widget_handle> handles;
+		for (int i = 0; i < 6; ++i) {
+			handles.emplace_back(nullptr);
+			widget_create(ztd::out_ptr::out_ptr(handles.back()));
+		}
+	}
+	REQUIRE(widgets_created == 6);
+	REQUIRE(widget_pool::size() == 4);
+	REQUIRE(widgets_destroyed == 2);
+	widget_pool::drain();
+	REQUIRE(widgets_destroyed == 6);
+}
+
+TEST_CASE("pooled_handle/threads", "each thread keeps its own handles, and destroys them when it exits") {
+	reset_widgets();
+	std::thread worker([]() {
+		widget_handle h(nullptr);
+		widget_re_create(ztd::out_ptr::inout_ptr(h));
+		h.reset();
+		// the main thread's pool is untouched
+		REQUIRE(widget_pool::size() == 1);
+	});
+	worker.join();
+	REQUIRE(widget_pool::size() == 0);
+	REQUIRE(widgets_created == 1);
+	REQUIRE(widgets_destroyed == 1);
+}
@@ -0,0 +1,221 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/preallocated_out_ptr.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	template <typename Left, typename Right>
+	bool same_control_block(const Left& left, const Right& right) {
+		return !left.owner_before(right) && !right.owner_before(left);
+	}
+} // namespace
+
+TEST_CASE("preallocated_out_ptr/basic", "preallocated_out_ptr allocates the control block up-front and commits into it") {
+	SECTION("shared_ptr<int>") {
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::int_deleter()));
+		int* rawp = p.get();
+		REQUIRE(rawp != nullptr);
+		REQUIRE(*rawp == ficapi_get_dynamic_data());
+		REQUIRE(p.use_count() == 1);
+	}
+	SECTION("shared_ptr<ficapi::opaque>") {
+		std::shared_ptr<ficapi::opaque> p(nullptr);
+		ficapi_handle_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::handle_deleter()));
+		ficapi::opaque_handle rawp = p.get();
+		REQUIRE(rawp != nullptr);
+		REQUIRE(ficapi_handle_get_data(rawp) == ficapi_get_dynamic_data());
+	}
+	SECTION("shared_ptr<ficapi::opaque>, void preallocated_out_ptr") {
+		std::shared_ptr<ficapi::opaque> p(nullptr);
+		ficapi_create(ztd::out_ptr::preallocated_out_ptr<void*>(p, ficapi::handle_deleter()), ficapi_type::ficapi_type_opaque);
+		ficapi::opaque_handle rawp = p.get();
+		REQUIRE(rawp != nullptr);
+		REQUIRE(ficapi_handle_get_data(rawp) == ficapi_get_dynamic_data());
+	}
+	SECTION("shared_ptr<void>, stateful deleter") {
+		std::shared_ptr<void> p(nullptr);
+		ficapi_create(ztd::out_ptr::preallocated_out_ptr(p, ficapi::stateful_deleter { 0x12345678, ficapi_type::ficapi_type_int }), ficapi_type::ficapi_type_int);
+		int* rawp = static_cast<int*>(p.get());
+		REQUIRE(rawp != nullptr);
+		REQUIRE(*rawp == ficapi_get_dynamic_data());
+	}
+}
+
+TEST_CASE("preallocated_out_ptr/ownership", "preallocated_out_ptr destroys the committed resource exactly once, with the given deleter") {
+	int deletions = 0;
+	{
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, counting_int_deleter { &deletions }));
+		REQUIRE(p != nullptr);
+		std::shared_ptr<int> q = p;
+		REQUIRE(p.use_count() == 2);
+		p.reset();
+		REQUIRE(deletions == 0);
+		REQUIRE(*q == ficapi_get_dynamic_data());
+	}
+	REQUIRE(deletions == 1);
+	{
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, counting_int_deleter { &deletions }));
+		ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, counting_int_deleter { &deletions }));
+		REQUIRE(deletions == 2);
+	}
+	REQUIRE(deletions == 3);
+}
+
+TEST_CASE("preallocated_out_ptr/failure", "preallocated_out_ptr never calls the deleter when nothing was written") {
+	int deletions = 0;
+	{
+		std::shared_ptr<int> p(nullptr);
+		int err = ficapi_int_create_fail(ztd::out_ptr::preallocated_out_ptr(p, counting_int_deleter { &deletions }), 1);
+		REQUIRE(err != 0);
+		REQUIRE(p.get() == nullptr);
+		// committed as an empty handle, as plain out_ptr does: the control block is not kept
+		REQUIRE(p.use_count() == 0);
+
+		ficapi_int_create(ztd::out_ptr::preallocated_out_ptr(p, counting_int_deleter { &deletions }));
+		REQUIRE(p != nullptr);
+		err = ficapi_int_create_fail(ztd::out_ptr::preallocated_out_ptr(p, counting_int_deleter { &deletions }), 1);
+		REQUIRE(err != 0);
+		REQUIRE(p.use_count() == 0);
+		REQUIRE(deletions == 1);
+	}
+	REQUIRE(deletions == 1);
+}
+
+TEST_CASE("preallocated_out_ptr/recycling", "recycling_out_ptr re-uses the control block of a uniquely-owned shared_ptr") {
+	int deletions = 0;
+	{
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_create(ztd::out_ptr::recycling_out_ptr(p, counting_int_deleter { &deletions }));
+		REQUIRE(p != nullptr);
+
+		std::shared_ptr<int> old_p = p;
+		ficapi_int_create(ztd::out_ptr::recycling_out_ptr(p, counting_int_deleter { &deletions }));
+		// shared: a fresh control block must be made
+		REQUIRE_FALSE(same_control_block(old_p, p));
+		REQUIRE(deletions == 0);
+		old_p.reset();
+		REQUIRE(deletions == 1);
+
+		// only used to identify the control block: a recycled handle must not be lock()ed
+		std::weak_ptr<int> before = p;
+		int* before_rawp		 = p.get();
+		ficapi_int_create(ztd::out_ptr::recycling_out_ptr(p, counting_int_deleter { &deletions }));
+		// unique: the same control block is re-seated with the new resource
+		REQUIRE(p.get() != before_rawp);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(p.use_count() == 1);
+		REQUIRE(deletions == 2);
+		REQUIRE(same_control_block(before, p));
+	}
+	REQUIRE(deletions == 3);
+}
+
+TEST_CASE("preallocated_out_ptr/recycling inout", "recycling_inout_ptr re-creates into the control block of a uniquely-owned shared_ptr") {
+	int deletions = 0;
+	{
+		std::shared_ptr<int> p(nullptr);
+		// empty: the C function is given null, and a control block is made
+		ficapi_int_re_create(ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions }));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+
+		// only used to identify the control block: a recycled handle must not be lock()ed
+		std::weak_ptr<int> before = p;
+		ficapi_int_re_create(ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions }));
+		// unique: the C function took over the old resource, and the control block is kept
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(p.use_count() == 1);
+		REQUIRE(deletions == 0);
+		REQUIRE(same_control_block(before, p));
+
+		REQUIRE(ztd::out_ptr::can_recycle_inout<counting_int_deleter>(p));
+	}
+	REQUIRE(deletions == 1);
+}
+
+TEST_CASE("preallocated_out_ptr/recycling inout rejected", "recycling_inout_ptr throws for a shared_ptr whose object others may still use") {
+	int deletions = 0;
+	{
+		std::shared_ptr<int> empty(nullptr);
+		REQUIRE(ztd::out_ptr::can_recycle_inout<counting_int_deleter>(empty));
+
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_re_create(ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions }));
+		std::shared_ptr<int> old_p = p;
+		int* old_rawp			  = p.get();
+		// shared: the C function would free the other owner's object, so it is never called
+		REQUIRE_FALSE(ztd::out_ptr::can_recycle_inout<counting_int_deleter>(p));
+		REQUIRE_THROWS_AS(ficapi_int_re_create(ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions })), std::invalid_argument);
+		REQUIRE(p.get() == old_rawp);
+		REQUIRE(same_control_block(old_p, p));
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(deletions == 0);
+
+		// the one owner, but of a control block made some other way
+		std::shared_ptr<int> foreign(new int(ficapi_get_dynamic_data()), counting_int_deleter { &deletions });
+		int* foreign_rawp = foreign.get();
+		REQUIRE_FALSE(ztd::out_ptr::can_recycle_inout<counting_int_deleter>(foreign));
+		REQUIRE_THROWS_AS(ficapi_int_re_create(ztd::out_ptr::recycling_inout_ptr(foreign, counting_int_deleter { &deletions })), std::invalid_argument);
+		REQUIRE(foreign.get() == foreign_rawp);
+		REQUIRE(foreign.use_count() == 1);
+		REQUIRE(deletions == 0);
+	}
+	REQUIRE(deletions == 2);
+}
+
+TEST_CASE("preallocated_out_ptr/recycling inout failure", "recycling_inout_ptr keeps the handle as it was when the C function fails") {
+	int deletions = 0;
+	{
+		std::shared_ptr<int> p(nullptr);
+		ficapi_int_re_create(ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions }));
+		std::weak_ptr<int> before = p;
+		int* rawp				 = p.get();
+
+		int err = ficapi_int_re_create_fail(ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions }), 1);
+		REQUIRE(err != 0);
+		REQUIRE(p.get() == rawp);
+		REQUIRE(same_control_block(before, p));
+
+		err = ztd::out_ptr::invoke(
+			ficapi_int_re_create_fail, [](int e) { return e == 0; }, ztd::out_ptr::recycling_inout_ptr(p, counting_int_deleter { &deletions }), 1);
+		REQUIRE(err != 0);
+		REQUIRE(p.get() == rawp);
+		REQUIRE(p.use_count() == 1);
+		REQUIRE(deletions == 0);
+
+		std::shared_ptr<int> empty(nullptr);
+		err = ztd::out_ptr::invoke(
+			ficapi_int_re_create_fail, [](int e) { return e == 0; }, ztd::out_ptr::recycling_inout_ptr(empty, counting_int_deleter { &deletions }), 1);
+		REQUIRE(err != 0);
+		REQUIRE(empty.use_count() == 0);
+	}
+	REQUIRE(deletions == 1);
+}
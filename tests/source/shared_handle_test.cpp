@@ -0,0 +1,182 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+
+#include <ztd/out_ptr/shared_handle.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/invoke.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct gadget {
+		int generation;
+	};
+
+	std::atomic<int> gadgets_destroyed(0);
+
+	void gadget_destroy(gadget* g) {
+		++gadgets_destroyed;
+		delete g;
+	}
+
+	void gadget_create(gadget** out) {
+		*out = new gadget { 0 };
+	}
+
+	// frees its input, as a realloc-style C function does, and fails when asked to
+	int gadget_re_create(gadget** inout, int fail) {
+		if (fail != 0) {
+			return -1;
+		}
+		int generation = *inout == nullptr ? 0 : (*inout)->generation + 1;
+		delete *inout;
+		*inout = new gadget { generation };
+		return 0;
+	}
+
+	bool is_ok(int err) {
+		return err == 0;
+	}
+
+	using gadget_handle		 = ztd::out_ptr::basic_shared_handle<gadget, decltype(&gadget_destroy), &gadget_destroy>;
+	using local_gadget_handle = ztd::out_ptr::basic_shared_handle<gadget, decltype(&gadget_destroy), &gadget_destroy, ztd::out_ptr::local_count>;
+} // namespace
+
+TEST_CASE("shared_handle/out_ptr", "out_ptr commits into a shared_handle, destroyed once by its last owner") {
+	gadgets_destroyed = 0;
+	{
+		gadget_handle h;
+		REQUIRE(h.use_count() == 0);
+		gadget_create(ztd::out_ptr::out_ptr(h));
+		REQUIRE(h);
+		REQUIRE(h->generation == 0);
+		REQUIRE(h.use_count() == 1);
+
+		gadget_handle copy = h;
+		REQUIRE(copy == h);
+		REQUIRE(h.use_count() == 2);
+		// shared: the other owner keeps the old object
+		gadget_create(ztd::out_ptr::out_ptr(h));
+		REQUIRE(copy != h);
+		REQUIRE(copy.use_count() == 1);
+		REQUIRE(h.use_count() == 1);
+		REQUIRE(gadgets_destroyed == 0);
+		copy.reset();
+		REQUIRE(gadgets_destroyed == 1);
+
+		// unique: the old object is destroyed, and the count is kept
+		gadget_create(ztd::out_ptr::out_ptr(h));
+		REQUIRE(gadgets_destroyed == 2);
+		REQUIRE(h.use_count() == 1);
+
+		gadget_handle moved = std::move(h);
+		REQUIRE_FALSE(h);
+		REQUIRE(moved.use_count() == 1);
+	}
+	REQUIRE(gadgets_destroyed == 3);
+}
+
+TEST_CASE("shared_handle/inout_ptr", "inout_ptr hands the object to the C function only when the handle is its one owner") {
+	gadgets_destroyed = 0;
+	{
+		gadget_handle h;
+		gadget_re_create(ztd::out_ptr::inout_ptr(h), 0);
+		REQUIRE(h->generation == 0);
+		gadget_re_create(ztd::out_ptr::inout_ptr(h), 0);
+		// the C function freed the old object itself
+		REQUIRE(h->generation == 1);
+		REQUIRE(h.use_count() == 1);
+		REQUIRE(gadgets_destroyed == 0);
+
+		gadget_handle copy = h;
+		gadget* before	   = h.get();
+		// the C function would free the object the copy still holds: it is never called
+		REQUIRE_THROWS_AS(gadget_re_create(ztd::out_ptr::inout_ptr(h), 0), std::invalid_argument);
+		REQUIRE(h.get() == before);
+		REQUIRE(h.use_count() == 2);
+		REQUIRE(copy->generation == 1);
+		REQUIRE(gadgets_destroyed == 0);
+	}
+	REQUIRE(gadgets_destroyed == 1);
+}
+
+TEST_CASE("shared_handle/invoke", "a failed re-create leaves a shared_handle as it was") {
+	gadgets_destroyed = 0;
+	{
+		gadget_handle h;
+		gadget_create(ztd::out_ptr::out_ptr(h));
+		gadget* before = h.get();
+		REQUIRE(ztd::out_ptr::invoke(gadget_re_create, is_ok, ztd::out_ptr::inout_ptr(h), 1) != 0);
+		REQUIRE(h.get() == before);
+		REQUIRE(h.use_count() == 1);
+
+		gadget_handle copy = h;
+		REQUIRE_THROWS_AS(ztd::out_ptr::invoke(gadget_re_create, is_ok, ztd::out_ptr::inout_ptr(h), 1), std::invalid_argument);
+		REQUIRE(h.get() == before);
+		REQUIRE(h.use_count() == 2);
+		REQUIRE(gadgets_destroyed == 0);
+	}
+	REQUIRE(gadgets_destroyed == 1);
+}
+
+TEST_CASE("shared_handle/local_count", "a local_count handle counts its owners without atomics") {
+	gadgets_destroyed = 0;
+	{
+		local_gadget_handle h;
+		gadget_create(ztd::out_ptr::out_ptr(h));
+		std::vector<local_gadget_handle> owners(8, h);
+		REQUIRE(h.use_count() == 9);
+		owners.clear();
+		REQUIRE(h.use_count() == 1);
+		gadget_re_create(ztd::out_ptr::inout_ptr(h), 0);
+		REQUIRE(h->generation == 1);
+		REQUIRE(gadgets_destroyed == 0);
+	}
+	REQUIRE(gadgets_destroyed == 1);
+}
+
+TEST_CASE("shared_handle/threads", "an atomic_count handle can be copied and dropped from many threads at once") {
+	gadgets_destroyed = 0;
+	std::atomic<int> failures(0);
+	{
+		gadget_handle h;
+		gadget_create(ztd::out_ptr::out_ptr(h));
+		std::vector<std::thread> workers;
+		for (int t = 0; t < 4; ++t) {
+			workers.emplace_back([&h, &failures]() {
+				for (int i = 0; i < 1000; ++i) {
+					gadget_handle mine = h;
+					if (mine->generation != 0) {
+						++failures;
+					}
+				}
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		REQUIRE(h.use_count() == 1);
+		REQUIRE(gadgets_destroyed == 0);
+	}
+	REQUIRE(failures == 0);
+	REQUIRE(gadgets_destroyed == 1);
+}
@@ -0,0 +1,125 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/static_deleter.hpp>
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+
+namespace {
+	int int_deletions = 0;
+
+	void counting_int_delete(int* p) {
+		++int_deletions;
+		ficapi_int_delete(p);
+	}
+
+	// makes a new int from an existing one: fails when given nothing to read
+	int int_derive(const int* from, int** out) {
+		if (from == nullptr) {
+			return -1;
+		}
+		ficapi_int_create(out);
+		**out = *from + 1;
+		return 0;
+	}
+
+	using int_handle    = ztd::out_ptr::basic_c_handle<int, decltype(&counting_int_delete), &counting_int_delete>;
+	using opaque_handle = ztd::out_ptr::basic_c_handle<ficapi_opaque, decltype(&ficapi_handle_delete), &ficapi_handle_delete>;
+} // namespace
+
+TEST_CASE("static_deleter/size", "handles with a static deleter are the size of their pointer") {
+	STATIC_REQUIRE(std::is_empty<int_handle::deleter_type>::value);
+	STATIC_REQUIRE(sizeof(int_handle) == sizeof(int*));
+	STATIC_REQUIRE(sizeof(opaque_handle) == sizeof(ficapi_opaque_handle));
+	STATIC_REQUIRE(ztd::out_ptr::is_static_deleter<int_handle::deleter_type>::value);
+	STATIC_REQUIRE_FALSE(ztd::out_ptr::is_static_deleter<void (*)(int*)>::value);
+#if ZTD_OUT_PTR_HAS_NONTYPE_TEMPLATE_PARAMETER_AUTO_I_
+	STATIC_REQUIRE(std::is_same<ztd::out_ptr::c_handle<int, &counting_int_delete>, int_handle>::value);
+#endif
+}
+
+TEST_CASE("static_deleter/selection", "handles with a static deleter take the clever paths") {
+#if ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ && !ZTD_OUT_PTR_USE_CLEVER_OUT_PTR_I_
+	STATIC_REQUIRE(std::is_base_of<ztd::out_ptr::op_detail::prenull_out_ptr_t<int_handle, int*>, ztd::out_ptr::out_ptr_t<int_handle, int*>>::value);
+#elif !ZTD_OUT_PTR_USE_CLEVER_OUT_PTR_I_
+	// the clever path nulls the handle before the call: it is never taken without asking
+	STATIC_REQUIRE_FALSE(std::is_base_of<ztd::out_ptr::op_detail::prenull_out_ptr_t<int_handle, int*>, ztd::out_ptr::out_ptr_t<int_handle, int*>>::value);
+#endif
+	STATIC_REQUIRE_FALSE(std::is_base_of<ztd::out_ptr::op_detail::prenull_out_ptr_t<std::unique_ptr<int, void (*)(int*)>, int*>,
+		ztd::out_ptr::out_ptr_t<std::unique_ptr<int, void (*)(int*)>, int*>>::value);
+}
+
+TEST_CASE("static_deleter/out_ptr", "out_ptr commits into a handle with a static deleter, and destroys the old value once") {
+	int_deletions = 0;
+	{
+		int_handle p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		int* old_rawp = p.get();
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		REQUIRE(p.get() != old_rawp);
+		REQUIRE(int_deletions == 1);
+
+		int err = ficapi_int_create_fail(ztd::out_ptr::out_ptr(p), 1);
+		REQUIRE(err != 0);
+		REQUIRE(p == nullptr);
+		REQUIRE(int_deletions == 2);
+	}
+	REQUIRE(int_deletions == 2);
+#if !ZTD_OUT_PTR_USE_CLEVER_STATIC_DELETER_OUT_PTR_I_ && !ZTD_OUT_PTR_USE_CLEVER_OUT_PTR_I_
+	{
+		// the handle still holds its old value for the rest of the call
+		int_handle p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		*p = 1;
+		REQUIRE(int_derive(p.get(), ztd::out_ptr::out_ptr(p)) == 0);
+		REQUIRE(*p == 2);
+		REQUIRE(int_deletions == 3);
+	}
+	REQUIRE(int_deletions == 4);
+#endif
+	{
+		opaque_handle p(nullptr);
+		ficapi_handle_create(ztd::out_ptr::out_ptr(p));
+		REQUIRE(p != nullptr);
+		REQUIRE(ficapi_handle_get_data(p.get()) == ficapi_get_dynamic_data());
+	}
+	{
+		opaque_handle p(nullptr);
+		ficapi_create(ztd::out_ptr::out_ptr<void*>(p), ficapi_type::ficapi_type_opaque);
+		REQUIRE(p != nullptr);
+		REQUIRE(ficapi_handle_get_data(p.get()) == ficapi_get_dynamic_data());
+	}
+}
+
+TEST_CASE("static_deleter/inout_ptr", "inout_ptr re-seats a handle with a static deleter without destroying the old value") {
+	int_deletions = 0;
+	{
+		int_handle p(nullptr);
+		ficapi_int_create(ztd::out_ptr::out_ptr(p));
+		ficapi_int_re_create(ztd::out_ptr::inout_ptr(p));
+		REQUIRE(p != nullptr);
+		REQUIRE(*p == ficapi_get_dynamic_data());
+		REQUIRE(int_deletions == 0);
+	}
+	REQUIRE(int_deletions == 1);
+}
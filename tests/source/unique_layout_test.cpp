@@ -0,0 +1,87 @@
+// Copyright ⓒ 2018-2023 ThePhD.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//  See https://github.com/ThePhD/out_ptr/blob/master/docs/out_ptr.adoc for documentation.
+#include <ztd/out_ptr/out_ptr.hpp>
+#include <ztd/out_ptr/inout_ptr.hpp>
+#include <ztd/out_ptr/detail/unique_layout.hpp>
+
+#include <ficapi/ficapi.hpp>
+
+#include <ztd/out_ptr/test/c_api.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+
+namespace {
+	using ztd::out_ptr::test::counting_int_deleter;
+
+	template <typename Layout, typename Smart>
+	bool aliased_pointer_is_get(Smart& p) {
+		return *static_cast<typename Smart::pointer*>(Layout::pointer_address(p)) == p.get();
+	}
+} // namespace
+
+TEST_CASE("unique_layout/model", "the modelled std::unique_ptr layout matches the real one for the deleters the clever paths accept") {
+	using empty_layout_t	= ztd::out_ptr::op_detail::std_unique_layout<int, ficapi::int_deleter>;
+	using stateful_layout_t	= ztd::out_ptr::op_detail::std_unique_layout<int, counting_int_deleter>;
+	using reference_layout_t = ztd::out_ptr::op_detail::std_unique_layout<int, counting_int_deleter&>;
+	STATIC_REQUIRE(empty_layout_t::matches);
+	STATIC_REQUIRE(stateful_layout_t::matches);
+	STATIC_REQUIRE(reference_layout_t::matches);
+
+	int deletions = 0;
+	counting_int_deleter d { &deletions };
+	std::unique_ptr<int, ficapi::int_deleter> empty_p(nullptr);
+	std::unique_ptr<int, counting_int_deleter> stateful_p(nullptr, d);
+	std::unique_ptr<int, counting_int_deleter&> reference_p(nullptr, d);
+	ficapi_int_create(ztd::out_ptr::op_detail::simple_out_ptr(empty_p));
+	ficapi_int_create(ztd::out_ptr::op_detail::simple_out_ptr(stateful_p));
+	ficapi_int_create(ztd::out_ptr::op_detail::simple_out_ptr(reference_p));
+	REQUIRE(aliased_pointer_is_get<empty_layout_t>(empty_p));
+	REQUIRE(aliased_pointer_is_get<stateful_layout_t>(stateful_p));
+	REQUIRE(aliased_pointer_is_get<reference_layout_t>(reference_p));
+}
+
+TEST_CASE("unique_layout/clever", "the clever paths commit through the modelled layout for stateful and reference deleters") {
+	int deletions = 0;
+	counting_int_deleter d { &deletions };
+	SECTION("stateful deleter") {
+		{
+			std::unique_ptr<int, counting_int_deleter> p(nullptr, d);
+			ficapi_int_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			ficapi_int_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(p.get_deleter().store == &deletions);
+		}
+		REQUIRE(deletions == 1);
+	}
+	SECTION("reference deleter") {
+		{
+			std::unique_ptr<int, counting_int_deleter&> p(nullptr, d);
+			ficapi_int_create(ztd::out_ptr::op_detail::clever_out_ptr(p));
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			ficapi_int_re_create(ztd::out_ptr::op_detail::clever_inout_ptr(p));
+			REQUIRE(p != nullptr);
+			REQUIRE(*p == ficapi_get_dynamic_data());
+			REQUIRE(&p.get_deleter() == &d);
+		}
+		REQUIRE(deletions == 1);
+	}
+}